@@ -0,0 +1,45 @@
+#include "HashUtil.hpp"
+
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+
+
+uint64_t common::HashUtil::hashBytes(const void* data, const size_t size, const uint64_t seed)
+{
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	uint64_t hash = seed;
+	for ( size_t i = 0; i < size; ++i ) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+std::string common::HashUtil::hashFile(const std::string& file)
+{
+	std::ifstream stream(file, std::ios::binary);
+	if ( !stream.is_open() ) {
+		throw std::runtime_error("Failed to open '" + file + "' for hashing.");
+	}
+
+	/** Hash in chunks */
+	uint64_t hash = 14695981039346656037ULL;
+	std::vector<char> buffer(64 * 1024);
+	while ( stream ) {
+		stream.read(buffer.data(), buffer.size());
+		hash = hashBytes(buffer.data(), static_cast<size_t>(stream.gcount()), hash);
+	}
+
+	return toHex(hash);
+}
+
+std::string common::HashUtil::toHex(const uint64_t hash)
+{
+	static const char digits[] = "0123456789abcdef";
+	std::string str(16, '0');
+	for ( size_t i = 0; i < 16; ++i ) {
+		str[15 - i] = digits[(hash >> (4 * i)) & 0xF];
+	}
+	return str;
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace common {
+	/**
+	 * General hashing utility
+	 */
+	class HashUtil
+	{
+	public:
+		/** Deleted Constructor */
+		HashUtil() = delete;
+
+		/** Deleted Constructor */
+		~HashUtil() = delete;
+
+		/**
+		 * @brief Hashes a block of memory using 64 bit FNV-1a.
+		 *
+		 * @param[in] data The data to hash.
+		 * @param[in] size The number of bytes to hash.
+		 * @param[in] seed The hash to continue from.
+		 *
+		 * @return The hash.
+		 */
+		static uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 14695981039346656037ULL);
+
+		/**
+		 * @brief Hashes the content of a file.
+		 *
+		 * @param[in] file The file to hash.
+		 *
+		 * @return The hash as a hex string.
+		 */
+		static std::string hashFile(const std::string& file);
+
+		/**
+		 * @brief Converts a hash to a fixed width hex string.
+		 *
+		 * @param[in] hash The hash.
+		 *
+		 * @return The hex string.
+		 */
+		static std::string toHex(uint64_t hash);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "LatencyTracker.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <iomanip>
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+#include "common/TimeUtil.hpp"
+
+
+namespace {
+	/** Nearest rank percentile of sorted latencies */
+	double getPercentile(const std::vector<double>& sortedLatencies, const double percentile)
+	{
+		const size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * static_cast<double>(sortedLatencies.size())));
+		return sortedLatencies[std::max<size_t>(rank, 1) - 1];
+	}
+}
+
+
+void common::LatencyTracker::begin()
+{
+	_traceStart = Clock::now();
+	++_trace;
+	_tracing = true;
+}
+
+void common::LatencyTracker::mark(const std::string& stage)
+{
+	if ( !_tracing ) {
+		return;
+	}
+	const double latency = std::chrono::duration<double, std::milli>(Clock::now() - _traceStart).count();
+
+	auto it = std::find_if(_stages.begin(), _stages.end(), [&stage](const Stage& s) { return s.name == stage; });
+	if ( it == _stages.end() ) {
+		Stage newStage;
+		newStage.name = stage;
+		it = _stages.insert(_stages.end(), newStage);
+	}
+
+	/** Only the first mark of a trace */
+	if ( it->markedTrace == _trace ) {
+		return;
+	}
+	it->markedTrace = _trace;
+	it->latencies.push_back(latency);
+}
+
+void common::LatencyTracker::end()
+{
+	_tracing = false;
+}
+
+std::vector<common::LatencyTracker::StageSummary> common::LatencyTracker::getSummaries() const
+{
+	std::vector<StageSummary> summaries;
+	summaries.reserve(_stages.size());
+	for ( const Stage& stage : _stages ) {
+		std::vector<double> latencies = stage.latencies;
+		std::sort(latencies.begin(), latencies.end());
+
+		StageSummary summary;
+		summary.stage = stage.name;
+		summary.count = latencies.size();
+		summary.mean = std::accumulate(latencies.begin(), latencies.end(), 0.0) / static_cast<double>(latencies.size());
+		summary.p50 = getPercentile(latencies, 50.0);
+		summary.p95 = getPercentile(latencies, 95.0);
+		summary.p99 = getPercentile(latencies, 99.0);
+		summary.max = latencies.back();
+		for ( const double latency : latencies ) {
+			const size_t bucket = static_cast<size_t>(std::lower_bound(BUCKET_BOUNDS.begin(), BUCKET_BOUNDS.end(), latency) - BUCKET_BOUNDS.begin());
+			++summary.histogram[bucket];
+		}
+		summaries.push_back(summary);
+	}
+
+	return summaries;
+}
+
+void common::LatencyTracker::write(std::ostream& stream) const
+{
+	const std::vector<StageSummary> summaries = getSummaries();
+
+	/** Percentiles */
+	stream << std::fixed << std::setprecision(1);
+	stream << "stage\tcount\tmean_ms\tp50_ms\tp95_ms\tp99_ms\tmax_ms\n";
+	for ( const StageSummary& summary : summaries ) {
+		stream << summary.stage << "\t" << summary.count << "\t" << summary.mean << "\t" << summary.p50 << "\t" << summary.p95 << "\t"
+			<< summary.p99 << "\t" << summary.max << "\n";
+	}
+
+	/** Histograms, one column per bucket */
+	stream << std::setprecision(0) << "\nstage";
+	for ( const double bound : BUCKET_BOUNDS ) {
+		stream << "\t<=" << bound << "ms";
+	}
+	stream << "\t>" << BUCKET_BOUNDS.back() << "ms\n";
+	for ( const StageSummary& summary : summaries ) {
+		stream << summary.stage;
+		for ( const size_t count : summary.histogram ) {
+			stream << "\t" << count;
+		}
+		stream << "\n";
+	}
+}
+
+void common::LatencyTracker::writeFile(const std::string& fileName, const std::string& title) const
+{
+	const boost::filesystem::path directory = boost::filesystem::path(fileName).parent_path();
+	if ( !directory.empty() ) {
+		boost::filesystem::create_directories(directory);
+	}
+
+	std::ofstream stream(fileName);
+	if ( !stream.is_open() ) {
+		throw std::runtime_error("Failed to open latency report '" + fileName + "'.");
+	}
+
+	stream << "# " << title << "\n# " << common::TimeUtil::getTimeNow() << "\n";
+	write(stream);
+}
+
+void common::LatencyTracker::clear()
+{
+	_stages.clear();
+	_tracing = false;
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <ostream>
+
+namespace common {
+	/**
+	 * Records the latency of the stages of an interaction, e.g. from an entry click until the audio is audible, and
+	 * aggregates them into a histogram per stage.
+	 *
+	 * A trace is started with begin and every stage marked afterwards records the time since the start of the trace.
+	 * Only the first mark of a stage is recorded per trace. The tracker is used from the GUI thread only.
+	 */
+	class LatencyTracker
+	{
+	public:
+		/**
+		 * @brief Shared Pointer
+		 */
+		typedef std::shared_ptr< LatencyTracker > Ptr;
+		typedef std::shared_ptr< const LatencyTracker > CPtr;
+
+		/** Upper bounds of the histogram buckets in milliseconds, the last bucket holds everything above */
+		static constexpr std::array<double, 12> BUCKET_BOUNDS = { 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000 };
+
+		struct StageSummary
+		{
+			std::string stage = "";
+			size_t count = 0;
+			double mean = 0.0;
+			double p50 = 0.0;
+			double p95 = 0.0;
+			double p99 = 0.0;
+			double max = 0.0;
+			std::array<size_t, BUCKET_BOUNDS.size() + 1> histogram = {};
+		};
+
+		/**
+		 * @brief Constructor
+		 */
+		LatencyTracker() = default;
+
+		/**
+		 * @brief Deleted the copy and assignment constructor.
+		 */
+		LatencyTracker(const LatencyTracker&) = delete;
+		LatencyTracker& operator=(const LatencyTracker&) = delete;
+
+		/**
+		 * @brief Starts a new trace, the stages of the previous trace that were not marked are not recorded.
+		 */
+		void begin();
+
+		/**
+		 * @brief Records the time since the start of the trace for a stage.
+		 *
+		 * @param[in] stage The name of the stage.
+		 */
+		void mark(const std::string& stage);
+
+		/**
+		 * @brief Ends the trace, stages marked after the end are not recorded.
+		 */
+		void end();
+
+		/**
+		 * @brief Returns the summaries of the recorded stages, in the order the stages were first marked.
+		 *
+		 * @return The summaries.
+		 */
+		std::vector<StageSummary> getSummaries() const;
+
+		/**
+		 * @brief Writes the summaries as a tab separated table followed by the histograms.
+		 *
+		 * @param[in] stream The stream.
+		 */
+		void write(std::ostream& stream) const;
+
+		/**
+		 * @brief Writes the summaries to a file, the directory of the file is created.
+		 *
+		 * @param[in] fileName The file.
+		 * @param[in] title The title written at the top of the file.
+		 */
+		void writeFile(const std::string& fileName, const std::string& title) const;
+
+		/**
+		 * @brief Removes all recorded latencies.
+		 */
+		void clear();
+	protected:
+		typedef std::chrono::steady_clock Clock;
+
+		struct Stage
+		{
+			std::string name = "";
+			std::vector<double> latencies;
+			size_t markedTrace = 0;
+		};
+
+		/** Variables */
+		Clock::time_point _traceStart;
+		size_t _trace = 0;
+		bool _tracing = false;
+
+		/** Stages in the order they were first marked, an interaction has a handful of stages */
+		std::vector<Stage> _stages;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "StringArena.hpp"
+
+#include <algorithm>
+
+#include "common/HashUtil.hpp"
+
+
+common::StringArena::StringArena(const size_t blockSize) :
+	_blockSize(blockSize), _used(blockSize), _table(1024)
+{
+}
+
+std::string_view common::StringArena::intern(const std::string_view str)
+{
+	char* data = reserve(str.size());
+	std::copy(str.begin(), str.end(), data);
+	return commit(std::string_view(data, str.size()));
+}
+
+std::string_view common::StringArena::internPath(const std::string_view directory, const std::string_view file)
+{
+	/** Join in place */
+	const size_t size = directory.size() + 1 + file.size();
+	char* data = reserve(size);
+	std::copy(directory.begin(), directory.end(), data);
+	data[directory.size()] = '/';
+	std::copy(file.begin(), file.end(), data + directory.size() + 1);
+	std::replace(data, data + size, '\\', '/');
+	return commit(std::string_view(data, size));
+}
+
+size_t common::StringArena::size() const
+{
+	return _size;
+}
+
+char* common::StringArena::reserve(const size_t size)
+{
+	/** Strings larger than a block get their own block */
+	if ( _used + size > _blockSize || _blocks.empty() ) {
+		_blocks.emplace_back(new char[std::max(size, _blockSize)]);
+		_used = 0;
+	}
+	return _blocks.back().get() + _used;
+}
+
+std::string_view common::StringArena::commit(const std::string_view str)
+{
+	/** Keep the table at most half full */
+	if ( (_size + 1) * 2 > _table.size() ) {
+		grow();
+	}
+
+	/** Open addressing with linear probing, the table size is a power of two */
+	const size_t mask = _table.size() - 1;
+	for ( size_t idx = common::HashUtil::hashBytes(str.data(), str.size()) & mask; ; idx = (idx + 1) & mask ) {
+		if ( _table[idx].data() == nullptr ) {
+			_table[idx] = str;
+			_used += str.size();
+			++_size;
+			return str;
+		}
+
+		/** Already interned, the reserved space is reused by the next string */
+		if ( _table[idx] == str ) {
+			return _table[idx];
+		}
+	}
+}
+
+void common::StringArena::grow()
+{
+	std::vector< std::string_view > table(_table.size() * 2);
+	const size_t mask = table.size() - 1;
+	for ( const std::string_view& str : _table ) {
+		if ( str.data() == nullptr ) {
+			continue;
+		}
+
+		size_t idx = common::HashUtil::hashBytes(str.data(), str.size()) & mask;
+		while ( table[idx].data() != nullptr ) {
+			idx = (idx + 1) & mask;
+		}
+		table[idx] = str;
+	}
+	_table.swap(table);
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <string_view>
+
+namespace common {
+	/**
+	 * Interns strings in large blocks such that many small strings share a few allocations.
+	 *
+	 * The returned views stay valid for the lifetime of the arena and equal strings are stored once.
+	 */
+	class StringArena
+	{
+	public:
+		/**
+		 * @brief Shared Pointer
+		 */
+		typedef std::shared_ptr< StringArena > Ptr;
+		typedef std::shared_ptr< const StringArena > CPtr;
+
+		/**
+		 * @brief Constructor
+		 *
+		 * @param[in] blockSize The size of the blocks the strings are stored in.
+		 */
+		explicit StringArena(size_t blockSize = 64 * 1024);
+
+		/**
+		 * @brief Deleted the copy and assignment constructor.
+		 */
+		StringArena(const StringArena&) = delete;
+		StringArena& operator=(const StringArena&) = delete;
+
+		/**
+		 * @brief Interns a string.
+		 *
+		 * @param[in] str The string.
+		 *
+		 * @return The interned string.
+		 */
+		std::string_view intern(std::string_view str);
+
+		/**
+		 * @brief Interns the path of a file in a directory. The parts are joined with '/' and '\' is replaced by '/'.
+		 *
+		 * @param[in] directory The directory.
+		 * @param[in] file The file relative to the directory.
+		 *
+		 * @return The interned path.
+		 */
+		std::string_view internPath(std::string_view directory, std::string_view file);
+
+		/**
+		 * @brief Returns the number of distinct strings in the arena.
+		 *
+		 * @return The number of strings.
+		 */
+		size_t size() const;
+
+	private:
+		/**
+		 * @brief Reserves space for a string at the end of the current block, a new block is started if needed.
+		 *
+		 * @param[in] size The size of the string.
+		 *
+		 * @return The reserved space.
+		 */
+		char* reserve(size_t size);
+
+		/**
+		 * @brief Adds the string at the end of the current block to the table, or releases it if the string is
+		 *        already interned.
+		 *
+		 * @param[in] str The reserved string.
+		 *
+		 * @return The interned string.
+		 */
+		std::string_view commit(std::string_view str);
+
+		/**
+		 * @brief Doubles the size of the table.
+		 */
+		void grow();
+
+		/** Variables */
+		size_t _blockSize = 0;
+		size_t _used = 0;
+		std::vector< std::unique_ptr<char[]> > _blocks;
+		std::vector< std::string_view > _table;
+		size_t _size = 0;
+	};
+}
\ No newline at end of file
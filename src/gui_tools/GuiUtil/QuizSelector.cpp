@@ -1,6 +1,7 @@
 #include "QuizSelector.hpp"
 
 #include <sstream>
+#include <algorithm>
 #include <stdexcept>
 
 #include <QLabel>
@@ -17,6 +18,8 @@
 #include <QListWidgetItem>
 
 #include "common/Log.hpp"
+#include "util/QuizCatalog.hpp"
+#include "util/FunctionTask.hpp"
 #include "util/QuizSettings.hpp"
 #include "gui_tools/widgets/QuizSettingsDialog.hpp"
 
@@ -30,28 +33,195 @@ MusicQuiz::QuizSelector::QuizSelector(QWidget* parent) :
 	/** Set Object Name */
 	setObjectName("QuizSelector");
 
-	/** Load Quizzes */
-	_quizList = MusicQuiz::util::QuizLoader::getListOfQuizzes();
+	/** Load Quizzes, the cached catalog is shown immediately and validated in the background by the catalog watcher.
+	    Nothing is cached on the first start such that the catalog is validated before the selector is shown */
+	const MusicQuiz::util::QuizCatalog::Ptr catalog = MusicQuiz::util::QuizLoader::getCatalog();
+	_quizList = catalog->getQuizPaths();
+	const bool cached = !_quizList.empty();
+	if ( !cached ) {
+		_quizList = MusicQuiz::util::QuizLoader::getListOfQuizzes();
+	}
+
 	if ( _quizList.empty() ) {
 		throw std::runtime_error("No quizzes available.");
 	}
 
+	_quizItems.resize(_quizList.size());
+
+	/** Create Layout */
+	createLayout();
+
 	/** Load Quiz Previews */
 	for ( size_t i = 0; i < _quizList.size(); ++i ) {
+		loadPreview(i);
+	}
+
+	/** Watch Catalog */
+	_catalogWatcher = new MusicQuiz::util::QuizCatalogWatcher(catalog, this);
+	connect(_catalogWatcher, SIGNAL(quizAdded(const QString&)), this, SLOT(addQuiz(const QString&)));
+	connect(_catalogWatcher, SIGNAL(quizModified(const QString&)), this, SLOT(updateQuiz(const QString&)));
+	connect(_catalogWatcher, SIGNAL(quizRemoved(const QString&)), this, SLOT(removeQuiz(const QString&)));
+
+	/** Validate the cached catalog, the changes are applied like any other change of the data folder */
+	if ( cached ) {
+		_catalogWatcher->refresh();
+	}
+
+	/** Set Fullscreen */
+	showFullScreen();
+}
+
+MusicQuiz::QuizSelector::~QuizSelector()
+{
+	/** Wait for the running previews, updates that are still queued are discarded together with the selector */
+	_previewPool.clear();
+	_previewPool.waitForDone();
+}
+
+void MusicQuiz::QuizSelector::loadPreview(const size_t idx)
+{
+	/** Sanity Check */
+	if ( idx >= _quizList.size() ) {
+		LOG_ERROR("Can not load quiz preview index out of range.")
+			return;
+	}
+	const std::string quizFile = _quizList[idx];
+
+	/** Cached Preview */
+	const MusicQuiz::util::QuizCatalog::Ptr catalog = MusicQuiz::util::QuizLoader::getCatalog();
+	QuizItem item;
+	item.loaded = true;
+
+	MusicQuiz::util::QuizCatalog::QuizRecord record;
+	const bool found = catalog->findQuiz(quizFile, record);
+	item.quizId = found ? record.contentHash : "";
+
+	/** The requested version of the quiz, previews of a previous version that are still loading are dropped */
+	_quizItems[idx].quizId = item.quizId;
+	if ( !found ) {
+		item.error = "Quiz does not exists.";
+		previewLoaded(quizFile, item);
+		return;
+	}
+
+	if ( record.previewValid || !record.previewError.empty() ) {
+		item.error = record.previewError;
+		item.preview = record.preview;
+		previewLoaded(quizFile, item);
+		return;
+	}
+
+	/** Parse the preview on the thread pool and update the list on the GUI thread */
+	++_pendingPreviews;
+	_previewPool.start(new MusicQuiz::util::FunctionTask([this, catalog, quizFile, item]() {
+		QuizItem loadedItem = item;
 		try {
-			_quizPreviews.push_back(MusicQuiz::util::QuizLoader::getQuizPreview(i));
+			loadedItem.preview = catalog->getPreview(quizFile);
 		} catch ( const std::exception& err ) {
-			LOG_ERROR("Failed to load quiz #" << i << ". " << err.what());
+			loadedItem.error = err.what();
 		} catch ( ... ) {
-			LOG_ERROR("Failed to load quiz #" << i << ".");
+			loadedItem.error = "Unknown error.";
+		}
+
+		QMetaObject::invokeMethod(this, [this, catalog, quizFile, loadedItem]() {
+			previewLoaded(quizFile, loadedItem);
+
+			/** Save the parsed previews once all are loaded */
+			if ( --_pendingPreviews == 0 && catalog->isDirty() ) {
+				catalog->save();
+			}
+		}, Qt::QueuedConnection);
+	}));
+}
+
+void MusicQuiz::QuizSelector::previewLoaded(const std::string& quizFile, const QuizItem& item)
+{
+	/** Find Quiz, it might have been removed or changed while the preview was loading */
+	size_t idx = 0;
+	if ( !findQuiz(quizFile, idx) || _quizSelectionList == nullptr || _quizItems[idx].quizId != item.quizId ) {
+		return;
+	}
+	_quizItems[idx] = item;
+
+	/** Update List Item */
+	QListWidgetItem* quizName = _quizSelectionList->item(static_cast<int>(idx));
+	if ( quizName != nullptr ) {
+		if ( item.error.empty() ) {
+			quizName->setText(QString(" ") + QString::fromStdString(item.preview.quizName));
+			quizName->setToolTip(QString());
+		} else {
+			LOG_ERROR("Failed to load quiz '" << quizFile << "'. " << item.error);
+			quizName->setText(QString(" Failed to load quiz"));
+			quizName->setToolTip(QString::fromStdString(quizFile + "\n" + item.error));
 		}
 	}
 
-	/** Create Layout */
-	createLayout();
+	/** Update Description */
+	if ( _quizSelectionList->currentRow() == static_cast<int>(idx) ) {
+		selectionClicked();
+	}
+}
 
-	/** Set Fullscreen */
-	showFullScreen();
+bool MusicQuiz::QuizSelector::findQuiz(const std::string& quizFile, size_t& idx) const
+{
+	const auto it = std::lower_bound(_quizList.begin(), _quizList.end(), quizFile);
+	if ( it == _quizList.end() || *it != quizFile ) {
+		return false;
+	}
+
+	idx = static_cast<size_t>(it - _quizList.begin());
+	return true;
+}
+
+void MusicQuiz::QuizSelector::addQuiz(const QString& quizFile)
+{
+	/** Insert the quiz such that the list stays sorted like the catalog */
+	const std::string quizFileStr = quizFile.toStdString();
+	const auto it = std::lower_bound(_quizList.begin(), _quizList.end(), quizFileStr);
+	if ( it != _quizList.end() && *it == quizFileStr ) {
+		return;
+	}
+
+	const size_t idx = static_cast<size_t>(it - _quizList.begin());
+	_quizList.insert(it, quizFileStr);
+	_quizItems.insert(_quizItems.begin() + idx, QuizItem());
+
+	QListWidgetItem* quizName = new QListWidgetItem;
+	quizName->setSizeHint(QSize(100, 100));
+	quizName->setTextAlignment(Qt::AlignCenter);
+	quizName->setText(QString(" Loading..."));
+	_quizSelectionList->insertItem(static_cast<int>(idx), quizName);
+
+	/** Load Preview */
+	loadPreview(idx);
+}
+
+void MusicQuiz::QuizSelector::updateQuiz(const QString& quizFile)
+{
+	/** Find Quiz */
+	size_t idx = 0;
+	if ( !findQuiz(quizFile.toStdString(), idx) ) {
+		addQuiz(quizFile);
+		return;
+	}
+
+	/** Reload Preview */
+	_quizItems[idx] = QuizItem();
+	loadPreview(idx);
+}
+
+void MusicQuiz::QuizSelector::removeQuiz(const QString& quizFile)
+{
+	/** Find Quiz */
+	size_t idx = 0;
+	if ( !findQuiz(quizFile.toStdString(), idx) ) {
+		return;
+	}
+
+	/** Remove Quiz */
+	_quizList.erase(_quizList.begin() + idx);
+	_quizItems.erase(_quizItems.begin() + idx);
+	delete _quizSelectionList->takeItem(static_cast<int>(idx));
 }
 
 void MusicQuiz::QuizSelector::createLayout()
@@ -82,12 +252,12 @@ void MusicQuiz::QuizSelector::createLayout()
 	connect(_quizSelectionList, SIGNAL(itemSelectionChanged()), this, SLOT(selectionClicked()));
 	_quizSelectionList->setCurrentRow(0);
 
-	/** Add Quizzes */
-	for ( size_t i = 0; i < _quizPreviews.size(); ++i ) {
+	/** Add Quizzes, the names are set as the previews are loaded */
+	for ( size_t i = 0; i < _quizItems.size(); ++i ) {
 		QListWidgetItem* quizName = new QListWidgetItem;
 		quizName->setSizeHint(QSize(100, 100));
 		quizName->setTextAlignment(Qt::AlignCenter);
-		quizName->setText(QString(" ") + QString::fromStdString(_quizPreviews[i].quizName));
+		quizName->setText(QString(" Loading..."));
 		_quizSelectionList->addItem(quizName);
 	}
 
@@ -184,7 +354,7 @@ void MusicQuiz::QuizSelector::createLayout()
 	setContentsMargins(20, 20, 20, 20);
 
 	/** Set Selected Quiz */
-	if ( !_quizPreviews.empty() ) {
+	if ( !_quizItems.empty() ) {
 		_quizSelectionList->setCurrentRow(0);
 	}
 }
@@ -192,7 +362,7 @@ void MusicQuiz::QuizSelector::createLayout()
 void MusicQuiz::QuizSelector::selectionClicked()
 {
 	/** Sanity Check */
-	if ( _quizPreviews.empty() ) {
+	if ( _quizItems.empty() ) {
 		LOG_ERROR("Can not update QuizSelection no previews loaded.")
 			return;
 	}
@@ -204,24 +374,36 @@ void MusicQuiz::QuizSelector::selectionClicked()
 
 	/** Current Index */
 	int currentIndex = _quizSelectionList->currentRow();
-	if ( currentIndex < 0 || static_cast<size_t>(currentIndex) >= _quizPreviews.size() ) {
+	if ( currentIndex < 0 || static_cast<size_t>(currentIndex) >= _quizItems.size() ) {
 		LOG_ERROR("Can not update QuizSelection index out of range.")
 			return;
 	}
 
+	/** Preview not available */
+	const QuizItem& item = _quizItems[currentIndex];
+	if ( !item.loaded || !item.error.empty() ) {
+		_descriptionText->setText(item.loaded ? QString::fromStdString("Failed to load quiz. " + item.error) : QString("Loading quiz..."));
+		_includeSongsCheckbox->setChecked(false);
+		_includeVideosCheckbox->setChecked(false);
+		_guessTheCategoryCheckbox->setChecked(false);
+		_categoryText->clear();
+		_rowCategoryText->clear();
+		return;
+	}
+
 	/** Update Description */
-	_descriptionText->setText(QString::fromStdString(_quizPreviews[currentIndex].quizDescription));
+	_descriptionText->setText(QString::fromStdString(item.preview.quizDescription));
 
 	/** Update Info Checkboxes */
-	_includeSongsCheckbox->setChecked(_quizPreviews[currentIndex].includeSongs);
-	_includeVideosCheckbox->setChecked(_quizPreviews[currentIndex].includeVideos);
-	_guessTheCategoryCheckbox->setChecked(_quizPreviews[currentIndex].guessTheCategory);
+	_includeSongsCheckbox->setChecked(item.preview.includeSongs);
+	_includeVideosCheckbox->setChecked(item.preview.includeVideos);
+	_guessTheCategoryCheckbox->setChecked(item.preview.guessTheCategory);
 
 	/** Update Categories */
 	std::stringstream ss("\n");
-	std::vector<std::string> categories = _quizPreviews[currentIndex].categories;
+	const std::vector<std::string>& categories = item.preview.categories;
 	for ( size_t i = 0; i < categories.size(); ++i ) {
-		if ( _quizPreviews[currentIndex].guessTheCategory ) {
+		if ( item.preview.guessTheCategory ) {
 			ss << i + 1 << ". Hidden\n\n";
 		} else {
 			ss << i + 1 << ". " << categories[i] << "\n\n";
@@ -230,7 +412,7 @@ void MusicQuiz::QuizSelector::selectionClicked()
 	_categoryText->setText(QString::fromStdString(ss.str()));
 
 	/** Row Cateogires */
-	std::vector<std::string> rowCategories = _quizPreviews[currentIndex].rowCategories;
+	const std::vector<std::string>& rowCategories = item.preview.rowCategories;
 	if ( !rowCategories.empty() ) {
 		ss.str("\n");
 		for ( size_t i = 0; i < rowCategories.size(); ++i ) {
@@ -246,7 +428,7 @@ void MusicQuiz::QuizSelector::selectionClicked()
 void MusicQuiz::QuizSelector::quizSelected()
 {
 	/** Sanity Check */
-	if ( _quizPreviews.empty() ) {
+	if ( _quizItems.empty() ) {
 		LOG_ERROR("Can not select quiz no quizzes loaded.")
 			return;
 	}
@@ -258,19 +440,29 @@ void MusicQuiz::QuizSelector::quizSelected()
 
 	/** Current Index */
 	int currentIndex = _quizSelectionList->currentRow();
-	if ( currentIndex < 0 || static_cast<size_t>(currentIndex) >= _quizPreviews.size() ) {
+	if ( currentIndex < 0 || static_cast<size_t>(currentIndex) >= _quizItems.size() ) {
 		LOG_ERROR("Can not select quiz index out of range.")
 			return;
 	}
 
+	/** Preview not available */
+	const QuizItem& item = _quizItems[currentIndex];
+	if ( !item.loaded ) {
+		QMessageBox::information(this, "Quiz Loading", "The quiz is still loading.");
+		return;
+	} else if ( !item.error.empty() ) {
+		QMessageBox::warning(this, "Failed to Load Quiz", QString::fromStdString("Failed to load the quiz. " + item.error));
+		return;
+	}
+
 	/** Quiz Name */
-	const QString quizName = QString::fromStdString(_quizPreviews[currentIndex].quizName);
+	const QString quizName = QString::fromStdString(item.preview.quizName);
 
 	/** Quiz Name */
-	const QString quizAuthor = QString::fromStdString(_quizPreviews[currentIndex].quizAuthor);
+	const QString quizAuthor = QString::fromStdString(item.preview.quizAuthor);
 
 	/** Guess The Category */
-	_settings.guessTheCategory = _quizPreviews[currentIndex].guessTheCategory;
+	_settings.guessTheCategory = item.preview.guessTheCategory;
 
 	/** Popup Messagebox */
 	QString msg = "Are you sure you want to select quiz '" + quizName + "'?";
@@ -278,7 +470,7 @@ void MusicQuiz::QuizSelector::quizSelected()
 		QMessageBox::No | QMessageBox::Yes, QMessageBox::Yes);
 
 	if ( resBtn == QMessageBox::Yes ) {
-		emit quizSelectedSignal(currentIndex, quizName, quizAuthor, _settings);
+		emit quizSelectedSignal(QString::fromStdString(item.quizId), quizName, quizAuthor, _settings);
 	}
 }
 
@@ -11,9 +11,11 @@
 #include <QTextEdit>
 #include <QKeyEvent>
 #include <QListWidget>
+#include <QThreadPool>
 
 #include "util/QuizLoader.hpp"
 #include "util/QuizSettings.hpp"
+#include "util/QuizCatalogWatcher.hpp"
 
 
 namespace MusicQuiz {
@@ -31,9 +33,9 @@ namespace MusicQuiz {
 		explicit QuizSelector(QWidget* parent = nullptr);
 
 		/**
-		 * @brief Destructor
+		 * @brief Destructor, waits for the preview loading to finish.
 		 */
-		virtual ~QuizSelector() = default;
+		virtual ~QuizSelector();
 
 		/**
 		 * @brief Deleted the copy and assignment constructor.
@@ -93,15 +95,71 @@ namespace MusicQuiz {
 		 */
 		void quit();
 
+		/**
+		 * @brief Adds a quiz that was added to the data folder.
+		 *
+		 * @param[in] quizFile The quiz file.
+		 */
+		void addQuiz(const QString& quizFile);
+
+		/**
+		 * @brief Reloads the preview of a quiz that was modified.
+		 *
+		 * @param[in] quizFile The quiz file.
+		 */
+		void updateQuiz(const QString& quizFile);
+
+		/**
+		 * @brief Removes a quiz that was removed from the data folder.
+		 *
+		 * @param[in] quizFile The quiz file.
+		 */
+		void removeQuiz(const QString& quizFile);
+
 	signals:
 		void quitSignal();
-		void quizSelectedSignal(size_t quizIdx, const QString& quizName, const QString& quizAuthor, const MusicQuiz::QuizSettings& settings);
+		void quizSelectedSignal(const QString& quizId, const QString& quizName, const QString& quizAuthor, const MusicQuiz::QuizSettings& settings);
 	protected:
+		struct QuizItem
+		{
+			bool loaded = false;
+			std::string quizId = "";
+			std::string error = "";
+			MusicQuiz::util::QuizLoader::QuizPreview preview;
+		};
+
 		/**
 		 * @brief Creates the category layout.
 		 */
 		void createLayout();
 
+		/**
+		 * @brief Loads a quiz preview. Cached previews are shown immediately and other previews are parsed on the
+		 *        preview thread pool.
+		 *
+		 * @param[in] idx The quiz index.
+		 */
+		void loadPreview(size_t idx);
+
+		/**
+		 * @brief Updates a quiz in the selection list when its preview is loaded. The preview is dropped if a
+		 *        different version of the quiz was requested since.
+		 *
+		 * @param[in] quizFile The quiz file.
+		 * @param[in] item The loaded quiz.
+		 */
+		void previewLoaded(const std::string& quizFile, const QuizItem& item);
+
+		/**
+		 * @brief Finds the index of a quiz in the selection list.
+		 *
+		 * @param[in] quizFile The quiz file.
+		 * @param[out] idx The quiz index.
+		 *
+		 * @return True if the quiz is in the list.
+		 */
+		bool findQuiz(const std::string& quizFile, size_t& idx) const;
+
 		/** Variables */
 		bool _quizClosed = false;
 
@@ -117,7 +175,11 @@ namespace MusicQuiz {
 		
 		MusicQuiz::QuizSettings _settings;
 
+		size_t _pendingPreviews = 0;
+		QThreadPool _previewPool;
+		MusicQuiz::util::QuizCatalogWatcher* _catalogWatcher = nullptr;
+
 		std::vector<std::string> _quizList;
-		std::vector<MusicQuiz::util::QuizLoader::QuizPreview> _quizPreviews;
+		std::vector<QuizItem> _quizItems;
 	};
-}
+}
\ No newline at end of file
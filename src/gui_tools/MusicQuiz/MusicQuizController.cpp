@@ -9,6 +9,7 @@
 #include <QApplication>
 
 #include "common/Log.hpp"
+#include "util/QuizLoader.hpp"
 #include "gui_tools/widgets/QuizFactory.hpp"
 #include "gui_tools/widgets/QuizCategory.hpp"
 #include "gui_tools/GuiUtil/QuizSelector.hpp"
@@ -36,6 +37,9 @@ MusicQuiz::MusicQuizController::MusicQuizController(QWidget* parent) :
 	/** Center Video Player */
 	_videoPlayer->move(0, 0);
 
+	/** Keep the video player mapped between the video entries */
+	_videoPlayer->setWarmSurface(true);
+
 	/** Connect Update Timer */
 	connect(&_updateTimer, SIGNAL(timeout()), this, SLOT(executeQuiz()));
 
@@ -94,6 +98,16 @@ MusicQuiz::MusicQuizController::~MusicQuizController()
 
 void MusicQuiz::MusicQuizController::executeQuiz()
 {
+	/** Prefetch the media of the selected quiz once its model is loaded */
+	if ( _prefetcher != nullptr && !_prefetchStarted && _quizModel.valid() && _quizModel.wait_for(std::chrono::seconds(0)) == std::future_status::ready ) {
+		_prefetchStarted = true;
+		try {
+			_prefetcher->start(_quizModel.get());
+		} catch ( const std::exception& err ) {
+			LOG_WARN("Failed to start media prefetching. " << err.what());
+		}
+	}
+
 	switch ( _quizState )
 	{
 	case MusicQuiz::MusicQuizController::SELECT_QUIZ:
@@ -106,7 +120,7 @@ void MusicQuiz::MusicQuizController::executeQuiz()
 
 		/** Connect Signals */
 		connect(_quizSelector, SIGNAL(quitSignal()), this, SLOT(quitQuiz()));
-		connect(_quizSelector, SIGNAL(quizSelectedSignal(size_t, const QString&, const QString&, const MusicQuiz::QuizSettings&)), this, SLOT(quizSelected(size_t, const QString&, const QString&, const MusicQuiz::QuizSettings&)));
+		connect(_quizSelector, SIGNAL(quizSelectedSignal(const QString&, const QString&, const QString&, const MusicQuiz::QuizSettings&)), this, SLOT(quizSelected(const QString&, const QString&, const QString&, const MusicQuiz::QuizSettings&)));
 
 		/** Show widget */
 		_quizSelector->exec();
@@ -173,9 +187,18 @@ void MusicQuiz::MusicQuizController::executeQuiz()
 			break;
 		}
 
+		/** Wait for the quiz model that is loaded since the quiz was selected */
+		if ( _quizModel.valid() && _quizModel.wait_for(std::chrono::seconds(0)) != std::future_status::ready ) {
+			break;
+		}
+
 		try {
 			/** Create Quiz Board */
-			_quizBoard = MusicQuiz::QuizFactory::createQuiz(_selectedQuizIdx, _settings, _audioPlayer, _videoPlayer, _teams);
+			if ( _quizModel.valid() ) {
+				_quizBoard = MusicQuiz::QuizFactory::createQuiz(_quizModel.get(), _settings, _audioPlayer, _videoPlayer, _teams);
+			} else {
+				_quizBoard = MusicQuiz::QuizFactory::createQuizById(_selectedQuizId, _settings, _audioPlayer, _videoPlayer, _teams);
+			}
 
 			/** Connect Signals */
 			connect(_quizBoard, SIGNAL(quitSignal()), this, SLOT(quitQuiz()));
@@ -237,17 +260,30 @@ void MusicQuiz::MusicQuizController::quitQuiz()
 	QApplication::quit();
 }
 
-void MusicQuiz::MusicQuizController::quizSelected(const size_t quizIdx, const QString& quizName, const QString& quizAuthor, const MusicQuiz::QuizSettings& settings)
+void MusicQuiz::MusicQuizController::quizSelected(const QString& quizId, const QString& quizName, const QString& quizAuthor, const MusicQuiz::QuizSettings& settings)
 {
 	/** Set Quiz Selected */
 	_quizSelected = true;
-	_selectedQuizIdx = quizIdx;
+	_selectedQuizId = quizId.toStdString();
 	_quizName = quizName;
 	_quizAuthor = quizAuthor;
 
 	/** Set Settings */
 	_settings = settings;
 
+	/** Load the quiz while the teams are selected and the intro is shown */
+	_quizModel = MusicQuiz::util::QuizLoader::loadQuizModelAsync(_selectedQuizId, _settings).share();
+
+	/** Read the media into the page cache in the background */
+	const bool prefetch = _settings.prefetchMedia && _settings.prefetchBandwidth > 0;
+	if ( prefetch && _prefetcher == nullptr ) {
+		_prefetcher = new MusicQuiz::util::MediaPrefetcher(_settings.prefetchBandwidth * 1024 * 1024, this);
+		connect(_prefetcher, SIGNAL(progress(quint64, quint64)), this, SLOT(prefetchProgress(quint64, quint64)));
+		connect(_prefetcher, SIGNAL(finished(quint64, double)), this, SLOT(prefetchFinished(quint64, double)));
+	}
+	_prefetchStarted = !prefetch;
+	_prefetchPercentage = 0;
+
 	/** Remove Quiz Selector */
 	_quizSelector->hide();
 	delete _quizSelector;
@@ -289,4 +325,19 @@ void MusicQuiz::MusicQuizController::quizCompleted(std::vector<MusicQuiz::QuizTe
 
 	/** Hide Quiz Board */
 	_quizBoard->hide();
+}
+
+void MusicQuiz::MusicQuizController::prefetchProgress(const quint64 prefetchedBytes, const quint64 totalBytes)
+{
+	/** Log every 10 percent */
+	const size_t percentage = totalBytes == 0 ? 100 : static_cast<size_t>(prefetchedBytes * 100 / totalBytes);
+	if ( percentage / 10 > _prefetchPercentage / 10 ) {
+		LOG_INFO("Prefetched " << percentage << "% of the quiz media (" << prefetchedBytes / (1024 * 1024) << " of " << totalBytes / (1024 * 1024) << " MB).");
+	}
+	_prefetchPercentage = percentage;
+}
+
+void MusicQuiz::MusicQuizController::prefetchFinished(const quint64 prefetchedBytes, const double seconds)
+{
+	LOG_INFO("Prefetched " << prefetchedBytes / (1024 * 1024) << " MB of quiz media in " << seconds << " s.");
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <atomic>
+#include <future>
 #include <memory>
 
 #include <QtGui>
@@ -13,7 +14,9 @@
 
 #include "ui_MusicQuizGUI.h"
 
+#include "util/QuizModel.hpp"
 #include "util/QuizSettings.hpp"
+#include "util/MediaPrefetcher.hpp"
 #include "media/AudioPlayer.hpp"
 #include "media/VideoPlayer.hpp"
 
@@ -77,12 +80,12 @@ namespace MusicQuiz {
 		/**
 		 * @brief Handles quiz selected.
 		 *
-		 * @param[in] quizIdx The selected quiz index.
+		 * @param[in] quizId The selected quiz id.
 		 * @param[in] quizName The selected quiz name.
 		 * @param[in] quizAuthor The selected quiz author.
 		 * @param[in] settings The quiz settings.
 		 */
-		void quizSelected(size_t quizIdx, const QString& quizName, const QString& quizAuthor, const MusicQuiz::QuizSettings& settings);
+		void quizSelected(const QString& quizId, const QString& quizName, const QString& quizAuthor, const MusicQuiz::QuizSettings& settings);
 
 		/**
 		 * @brief Handles team selected.
@@ -101,6 +104,22 @@ namespace MusicQuiz {
 		 */
 		void quizCompleted(std::vector<MusicQuiz::QuizTeam*> winningTeam);
 
+		/**
+		 * @brief Handles the progress of the media prefetching.
+		 *
+		 * @param[in] prefetchedBytes The number of bytes read.
+		 * @param[in] totalBytes The number of bytes that will be read.
+		 */
+		void prefetchProgress(quint64 prefetchedBytes, quint64 totalBytes);
+
+		/**
+		 * @brief Handles the completed media prefetching.
+		 *
+		 * @param[in] prefetchedBytes The number of bytes read.
+		 * @param[in] seconds The duration of the prefetching.
+		 */
+		void prefetchFinished(quint64 prefetchedBytes, double seconds);
+
 	private:
 
 		/** Variables */
@@ -128,11 +147,17 @@ namespace MusicQuiz {
 		QuizState _quizState = QuizState::SELECT_QUIZ;
 
 		/** Quiz Settings */
-		size_t _selectedQuizIdx = 0;
+		std::string _selectedQuizId = "";
+		std::shared_future< MusicQuiz::util::QuizModel::CPtr > _quizModel;
 		QString _quizName = "";
 		QString _quizAuthor = "";
 		MusicQuiz::QuizSettings _settings;
 
+		/** Media Prefetching, started once the quiz model is loaded */
+		MusicQuiz::util::MediaPrefetcher* _prefetcher = nullptr;
+		bool _prefetchStarted = false;
+		size_t _prefetchPercentage = 0;
+
 		/** Audio Player */
 		std::shared_ptr<media::AudioPlayer> _audioPlayer = nullptr;
 
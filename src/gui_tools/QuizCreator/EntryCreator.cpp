@@ -442,6 +442,19 @@ void MusicQuiz::EntryCreator::stop()
 	}
 }
 
+void MusicQuiz::EntryCreator::releaseMedia()
+{
+	/** Release Audio */
+	if ( _audioPlayer != nullptr ) {
+		_audioPlayer->releaseMedia();
+	}
+
+	/** Release Video */
+	if ( _videoPlayer != nullptr ) {
+		_videoPlayer->releaseMedia();
+	}
+}
+
 void MusicQuiz::EntryCreator::playVideo()
 {
 	/** Sanity Check */
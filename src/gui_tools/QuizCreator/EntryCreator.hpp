@@ -211,6 +211,11 @@ namespace MusicQuiz {
 		 */
 		void stop();
 
+		/**
+		 * @brief Stops the audio and video and closes their media files.
+		 */
+		void releaseMedia();
+
 	private slots:
 		/**
 		 * @brief Opens a dialog to browse for a song file.
@@ -33,6 +33,11 @@ MusicQuiz::LoadQuizDialog::LoadQuizDialog(QWidget* parent) :
 
 	/** Update Table */
 	updateTable();
+
+	/** Watch Catalog */
+	_catalogWatcher = new MusicQuiz::util::QuizCatalogWatcher(MusicQuiz::util::QuizLoader::getCatalog(), this);
+	connect(_catalogWatcher, SIGNAL(quizAdded(const QString&)), this, SLOT(addQuiz(const QString&)));
+	connect(_catalogWatcher, SIGNAL(quizRemoved(const QString&)), this, SLOT(removeQuiz(const QString&)));
 }
 
 void MusicQuiz::LoadQuizDialog::makeWidgetLayout()
@@ -90,33 +95,85 @@ void MusicQuiz::LoadQuizDialog::updateTable()
 	_quizList = MusicQuiz::util::QuizLoader::getListOfQuizzes();
 
 	/** Update Table */
-	for ( unsigned int i = 0; i < _quizList.size(); ++i ) {
-		/** Add Row */
-		const int row = _quizTable->rowCount();
-		_quizTable->insertRow(row);
-
-		/** Quiz Name */
-		std::string quizName = _quizList[i].substr(_quizList[i].find_last_of("\\") + 1);
-		const std::string fileExtension = ".quiz.xml";
-		quizName.erase(quizName.find(fileExtension), fileExtension.length());
-
-		/** Radio Button */
-		QWidget* btnWidget = new QWidget(this);
-		QHBoxLayout* btnLayout = new QHBoxLayout(btnWidget);
-
-		QRadioButton* btn = new QRadioButton(QString::fromStdString(quizName));
-		btn->setObjectName("quizCreatorRadioButton");
-		btn->setProperty("index", i);
-		if ( i == 0 ) {
-			btn->setChecked(true);
-		}
-		_buttonGroup->addButton(btn, i);
+	for ( size_t i = 0; i < _quizList.size(); ++i ) {
+		insertRow(static_cast<int>(i), _quizList[i]);
+	}
+
+	/** Select First Quiz */
+	if ( !_buttonGroup->buttons().isEmpty() ) {
+		_buttonGroup->buttons().front()->setChecked(true);
+	}
+}
+
+void MusicQuiz::LoadQuizDialog::insertRow(const int row, const std::string& quizFile)
+{
+	/** Add Row */
+	_quizTable->insertRow(row);
+
+	/** Quiz Name */
+	std::string quizName = quizFile.substr(quizFile.find_last_of("/\\") + 1);
+	const std::string fileExtension = ".quiz.xml";
+	quizName.erase(quizName.find(fileExtension), fileExtension.length());
+
+	/** Radio Button */
+	QWidget* btnWidget = new QWidget(this);
+	QHBoxLayout* btnLayout = new QHBoxLayout(btnWidget);
+
+	QRadioButton* btn = new QRadioButton(QString::fromStdString(quizName));
+	btn->setObjectName("quizCreatorRadioButton");
+	btn->setProperty("quizFile", QString::fromStdString(quizFile));
+	_buttonGroup->addButton(btn);
+
+	btnLayout->addWidget(btn, Qt::AlignCenter | Qt::AlignVCenter);
+	btnWidget->setLayout(btnLayout);
+	btnLayout->setAlignment(Qt::AlignCenter);
+	_quizTable->setCellWidget(row, 0, btnWidget);
+}
+
+void MusicQuiz::LoadQuizDialog::addQuiz(const QString& quizFile)
+{
+	/** Sanity Check */
+	if ( _quizTable == nullptr ) {
+		return;
+	}
 
-		btnLayout->addWidget(btn, Qt::AlignCenter | Qt::AlignVCenter);
-		btnWidget->setLayout(btnLayout);
-		btnLayout->setAlignment(Qt::AlignCenter);
-		_quizTable->setCellWidget(row, 0, btnWidget);
+	/** Insert the quiz such that the table stays sorted */
+	const std::string quizFileStr = quizFile.toStdString();
+	const auto it = std::lower_bound(_quizList.begin(), _quizList.end(), quizFileStr);
+	if ( it != _quizList.end() && *it == quizFileStr ) {
+		return;
+	}
+
+	const int row = static_cast<int>(it - _quizList.begin());
+	_quizList.insert(it, quizFileStr);
+	insertRow(row, quizFileStr);
+}
+
+void MusicQuiz::LoadQuizDialog::removeQuiz(const QString& quizFile)
+{
+	/** Sanity Check */
+	if ( _quizTable == nullptr ) {
+		return;
+	}
+
+	/** Find Quiz */
+	const std::string quizFileStr = quizFile.toStdString();
+	const auto it = std::lower_bound(_quizList.begin(), _quizList.end(), quizFileStr);
+	if ( it == _quizList.end() || *it != quizFileStr ) {
+		return;
+	}
+
+	/** Remove Row */
+	const int row = static_cast<int>(it - _quizList.begin());
+	_quizList.erase(it);
+	QWidget* btnWidget = _quizTable->cellWidget(row, 0);
+	if ( btnWidget != nullptr ) {
+		QRadioButton* btn = btnWidget->findChild<QRadioButton*>();
+		if ( btn != nullptr ) {
+			_buttonGroup->removeButton(btn);
+		}
 	}
+	_quizTable->removeRow(row);
 }
 
 void MusicQuiz::LoadQuizDialog::loadQuiz()
@@ -132,11 +189,10 @@ void MusicQuiz::LoadQuizDialog::loadQuiz()
 		close();
 		return;
 	}
-	const size_t idx = btn->property("index").toInt();
+	const std::string quizFile = btn->property("quizFile").toString().toStdString();
 
 	/** Emit Signal */
-	std::replace(_quizList[idx].begin(), _quizList[idx].end(), '\\', '/');
-	emit loadSignal(_quizList[idx]);
+	emit loadSignal(quizFile);
 
 	/** Close Dialog */
 	close();
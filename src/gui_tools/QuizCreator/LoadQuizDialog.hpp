@@ -9,6 +9,7 @@
 #include <QButtonGroup>
 
 #include "util/QuizLoader.hpp"
+#include "util/QuizCatalogWatcher.hpp"
 
 class QTableWidget;
 
@@ -49,6 +50,20 @@ namespace MusicQuiz {
 		 */
 		void loadQuiz();
 
+		/**
+		 * @brief Adds a quiz that was added to the data folder.
+		 *
+		 * @param[in] quizFile The quiz file.
+		 */
+		void addQuiz(const QString& quizFile);
+
+		/**
+		 * @brief Removes a quiz that was removed from the data folder.
+		 *
+		 * @param[in] quizFile The quiz file.
+		 */
+		void removeQuiz(const QString& quizFile);
+
 	signals:
 		void loadSignal(const std::string&);
 
@@ -58,9 +73,18 @@ namespace MusicQuiz {
 		 */
 		void makeWidgetLayout();
 
+		/**
+		 * @brief Inserts a quiz in the table.
+		 *
+		 * @param[in] row The row.
+		 * @param[in] quizFile The quiz file.
+		 */
+		void insertRow(int row, const std::string& quizFile);
+
 		/** Variables */
 		QTableWidget* _quizTable = nullptr;
 		QButtonGroup* _buttonGroup = nullptr;
+		MusicQuiz::util::QuizCatalogWatcher* _catalogWatcher = nullptr;
 
 		std::vector<std::string> _quizList;
 	};
@@ -123,6 +123,48 @@ void MusicQuiz::QuizCreator::createLayout()
 	_hiddenCategoriesCheckbox->setObjectName("quizCreatorCheckbox");
 	setupTabLayout->addWidget(_hiddenCategoriesCheckbox, ++row, 0, 1, 2);
 
+	_extractClipsCheckbox = new QCheckBox("Extract Clips");
+	_extractClipsCheckbox->setObjectName("quizCreatorCheckbox");
+	_extractClipsCheckbox->setToolTip("Only the played parts of the media files are saved. Requires ffmpeg.");
+	setupTabLayout->addWidget(_extractClipsCheckbox, ++row, 0, 1, 2);
+
+	label = new QLabel("Clip Pre-roll (s):");
+	label->setObjectName("quizCreatorLabel");
+	setupTabLayout->addWidget(label, ++row, 0, 1, 1, Qt::AlignLeft);
+
+	_clipPreRollSpinbox = new QSpinBox;
+	_clipPreRollSpinbox->setAlignment(Qt::AlignCenter);
+	_clipPreRollSpinbox->setObjectName("quizCreatorSpinbox");
+	_clipPreRollSpinbox->setRange(0, 60);
+	_clipPreRollSpinbox->setValue(2);
+	_clipPreRollSpinbox->setEnabled(false);
+	connect(_extractClipsCheckbox, SIGNAL(toggled(bool)), _clipPreRollSpinbox, SLOT(setEnabled(bool)));
+	setupTabLayout->addWidget(_clipPreRollSpinbox, row, 1, 1, 1);
+
+	label = new QLabel("Clip Post-roll (s):");
+	label->setObjectName("quizCreatorLabel");
+	setupTabLayout->addWidget(label, ++row, 0, 1, 1, Qt::AlignLeft);
+
+	_clipPostRollSpinbox = new QSpinBox;
+	_clipPostRollSpinbox->setAlignment(Qt::AlignCenter);
+	_clipPostRollSpinbox->setObjectName("quizCreatorSpinbox");
+	_clipPostRollSpinbox->setRange(5, 600);
+	_clipPostRollSpinbox->setValue(30);
+	_clipPostRollSpinbox->setEnabled(false);
+	connect(_extractClipsCheckbox, SIGNAL(toggled(bool)), _clipPostRollSpinbox, SLOT(setEnabled(bool)));
+	setupTabLayout->addWidget(_clipPostRollSpinbox, row, 1, 1, 1);
+
+	_sharedMediaCheckbox = new QCheckBox("Shared Media");
+	_sharedMediaCheckbox->setObjectName("quizCreatorCheckbox");
+	_sharedMediaCheckbox->setToolTip("The media files are stored once in ./data/.media/ and shared by all quizzes using them.");
+	setupTabLayout->addWidget(_sharedMediaCheckbox, ++row, 0, 1, 2);
+
+	_writePackCheckbox = new QCheckBox("Write Pack");
+	_writePackCheckbox->setObjectName("quizCreatorCheckbox");
+	_writePackCheckbox->setToolTip("The media files are also written to a single pack file that is mapped when the quiz is played. The pack is a second copy of the media. Not available with shared media.");
+	connect(_sharedMediaCheckbox, SIGNAL(toggled(bool)), _writePackCheckbox, SLOT(setDisabled(bool)));
+	setupTabLayout->addWidget(_writePackCheckbox, ++row, 0, 1, 2);
+
 	/** Setup Tab - Categories */
 	label = new QLabel("Categories:");
 	label->setObjectName("quizCreatorLabel");
@@ -488,13 +530,13 @@ const std::vector< QString > MusicQuiz::QuizCreator::getRowCategories() const
 
 void MusicQuiz::QuizCreator::saveQuiz()
 {
-	/** Stop Song */
-	_audioPlayer->stop();
+	/** Release Media, the save replaces and removes the media files that were played */
+	_audioPlayer->releaseMedia();
+	_videoPlayer->releaseMedia();
 
-	/** Stop Video */
 	for ( size_t i = 0; i < _categories.size(); ++i ) {
 		for ( size_t j = 0; j < _categories[i]->getEntries().size(); ++j ) {
-			_categories[i]->getEntries()[j]->stop();
+			_categories[i]->getEntries()[j]->releaseMedia();
 		}
 	}
 
@@ -514,6 +556,16 @@ void MusicQuiz::QuizCreator::saveQuiz()
 	quizData.guessTheCategory = _hiddenCategoriesCheckbox->isChecked();
 	quizData.guessTheCategoryPoints = 500; // \todo implement this.
 
+	/** Clip Extraction */
+	quizData.extractClips = _extractClipsCheckbox->isChecked();
+	quizData.clipPreRoll = static_cast<size_t>(_clipPreRollSpinbox->value()) * 1000;
+	quizData.clipPostRoll = static_cast<size_t>(_clipPostRollSpinbox->value()) * 1000;
+	quizData.clips = _clips;
+
+	/** Shared Media */
+	quizData.sharedMedia = _sharedMediaCheckbox->isChecked();
+	quizData.writePack = _writePackCheckbox->isEnabled() && _writePackCheckbox->isChecked();
+
 	/** Quiz Categories */
 	quizData.quizCategories = _categories;
 
@@ -676,6 +728,21 @@ void MusicQuiz::QuizCreator::loadQuiz(const std::string& quizName)
 		}
 	}
 
+	/** Clip Extraction */
+	_clips = quizData.clips;
+	if ( _extractClipsCheckbox != nullptr ) {
+		_extractClipsCheckbox->setChecked(quizData.extractClips);
+	}
+
+	/** Shared Media */
+	if ( _sharedMediaCheckbox != nullptr ) {
+		_sharedMediaCheckbox->setChecked(quizData.sharedMedia);
+	}
+
+	if ( _writePackCheckbox != nullptr ) {
+		_writePackCheckbox->setChecked(quizData.writePack);
+	}
+
 	/** Hidden Categories */
 	if ( _hiddenCategoriesCheckbox != nullptr ) {
 		_hiddenCategoriesCheckbox->setChecked(quizData.guessTheCategory);
@@ -729,14 +796,14 @@ void MusicQuiz::QuizCreator::stopQuizPreview()
 		return;
 	}
 
-	/** Stop Audio */
+	/** Release Audio, the media files of the quiz are closed such that the quiz can be saved again */
 	if ( _audioPlayer != nullptr ) {
-		_audioPlayer->stop();
+		_audioPlayer->releaseMedia();
 	}
 
-	/** Stop Video */
+	/** Release Video */
 	if ( _videoPlayer != nullptr ) {
-		_videoPlayer->stop();
+		_videoPlayer->releaseMedia();
 		_videoPlayer->hide();
 	}
 
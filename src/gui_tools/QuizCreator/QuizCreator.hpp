@@ -1,5 +1,7 @@
 #pragma once
 
+#include <map>
+#include <string>
 #include <vector>
 
 #include <QObject>
@@ -7,6 +9,7 @@
 #include <QDialog>
 #include <QTextEdit>
 #include <QLineEdit>
+#include <QSpinBox>
 #include <QCheckBox>
 #include <QTabWidget>
 #include <QTableWidget>
@@ -23,6 +26,13 @@ namespace MusicQuiz {
 	{
 		Q_OBJECT
 	public:
+		/** A clip of a media file, with its offset in the source file */
+		struct Clip
+		{
+			size_t offset = 0;
+			std::string source = "";
+		};
+
 		struct QuizData
 		{
 			QString quizName = "";
@@ -34,6 +44,20 @@ namespace MusicQuiz {
 
 			std::vector< QString > quizRowCategories;
 			std::vector< MusicQuiz::CategoryCreator* > quizCategories;
+
+			/** Only the played parts of the media are saved, with a pre and post roll in milliseconds */
+			bool extractClips = false;
+			size_t clipPreRoll = 2000;
+			size_t clipPostRoll = 30000;
+
+			/** The clips of the loaded quiz by media file, media that is still a saved clip keeps its source */
+			std::map< std::string, Clip > clips;
+
+			/** The media is saved in the media store shared by all quizzes instead of the media folder of the quiz */
+			bool sharedMedia = false;
+
+			/** A pack of the media is written next to the quiz, it doubles the disk space of the media */
+			bool writePack = false;
 		};
 
 		/**
@@ -152,11 +176,17 @@ namespace MusicQuiz {
 		QTextEdit* _quizDescriptionTextEdit = nullptr;
 
 		QCheckBox* _hiddenCategoriesCheckbox = nullptr;
+		QCheckBox* _extractClipsCheckbox = nullptr;
+		QCheckBox* _sharedMediaCheckbox = nullptr;
+		QCheckBox* _writePackCheckbox = nullptr;
+		QSpinBox* _clipPreRollSpinbox = nullptr;
+		QSpinBox* _clipPostRollSpinbox = nullptr;
 
 		QTableWidget* _categoriesTable = nullptr;
 		QTableWidget* _rowCategoriesTable = nullptr;
 
 		std::vector< MusicQuiz::CategoryCreator* > _categories;
+		std::map< std::string, Clip > _clips;
 
 		/** Audio Player */
 		std::shared_ptr<media::AudioPlayer> _audioPlayer = nullptr;
@@ -11,6 +11,7 @@
 #include <QMessageBox>
 #include <QWindow>
 #include <QScreen>
+#include <QDateTime>
 
 #include "common/Log.hpp"
 
@@ -59,6 +60,9 @@ MusicQuiz::QuizBoard::QuizBoard(const std::vector<MusicQuiz::QuizCategory*>& cat
 	/** Create Widget Layout */
 	createLayout();
 
+	/** Preload Media */
+	preloadEntries();
+
 	/** Install event filter in all child widgets */
 	QList<QWidget*> widgets = findChildren<QWidget*>();
 	for ( QWidget* widget : widgets ) {
@@ -68,6 +72,57 @@ MusicQuiz::QuizBoard::QuizBoard(const std::vector<MusicQuiz::QuizCategory*>& cat
 	}
 }
 
+void MusicQuiz::QuizBoard::preloadEntries()
+{
+	/** Idle Entries */
+	std::vector<MusicQuiz::QuizEntry*> idleEntries;
+	for ( size_t i = 0; i < _categories.size(); ++i ) {
+		for ( size_t j = 0; j < _categories[i]->getSize(); ++j ) {
+			MusicQuiz::QuizEntry* quizEntry = (*_categories[i])[j];
+			if ( quizEntry != nullptr && quizEntry->getEntryState() == QuizEntry::EntryState::IDLE ) {
+				idleEntries.push_back(quizEntry);
+			}
+		}
+	}
+
+	/** Small Board, every idle entry fits in the pool. Only the hovered entry prerolls its video */
+	MusicQuiz::QuizEntry* hoveredEntry = dynamic_cast<MusicQuiz::QuizEntry*>(sender());
+	if ( idleEntries.size() <= media::AudioPlayer::getPreloadCapacity() ) {
+		for ( MusicQuiz::QuizEntry* quizEntry : idleEntries ) {
+			quizEntry->preload(quizEntry == hoveredEntry);
+		}
+		return;
+	}
+
+	/** Large Board, the neighbours of the hovered entry and the hovered entry last such that it is kept the longest */
+	if ( hoveredEntry == nullptr || hoveredEntry->getEntryState() == QuizEntry::EntryState::PLAYED ) {
+		return;
+	}
+
+	for ( size_t i = 0; i < _categories.size(); ++i ) {
+		for ( size_t j = 0; j < _categories[i]->getSize(); ++j ) {
+			if ( (*_categories[i])[j] != hoveredEntry ) {
+				continue;
+			}
+
+			const auto preloadIdle = [this](const size_t category, const size_t entry) {
+				if ( category < _categories.size() && entry < _categories[category]->getSize() ) {
+					MusicQuiz::QuizEntry* quizEntry = (*_categories[category])[entry];
+					if ( quizEntry != nullptr && quizEntry->getEntryState() == QuizEntry::EntryState::IDLE ) {
+						quizEntry->preload(false);
+					}
+				}
+			};
+			preloadIdle(i, j - 1);
+			preloadIdle(i, j + 1);
+			preloadIdle(i - 1, j);
+			preloadIdle(i + 1, j);
+			hoveredEntry->preload(true);
+			return;
+		}
+	}
+}
+
 void MusicQuiz::QuizBoard::createLayout()
 {
 	/** Layout */
@@ -94,6 +149,8 @@ void MusicQuiz::QuizBoard::createLayout()
 			if ( quizEntry != nullptr ) {
 				connect(quizEntry, SIGNAL(answered(size_t)), this, SLOT(handleAnswer(size_t)));
 				connect(quizEntry, SIGNAL(played()), this, SLOT(handleGameComplete()));
+				connect(quizEntry, SIGNAL(played()), this, SLOT(preloadEntries()));
+				connect(quizEntry, SIGNAL(hovered()), this, SLOT(preloadEntries()));
 			}
 		}
 
@@ -242,6 +299,10 @@ void MusicQuiz::QuizBoard::handleGameComplete()
 		}
 	}
 
+	if ( isGameComplete || _quizStopped ) {
+		writeLatencyReport();
+	}
+
 	if ( (isGameComplete || _quizStopped) && !_teams.empty() ) {
 		/** Find Winner */
 		const size_t highScore = (*std::max_element(_teams.begin(), _teams.end(), [](const MusicQuiz::QuizTeam* a, const MusicQuiz::QuizTeam* b) {return a->getScore() < b->getScore(); }))->getScore();
@@ -263,6 +324,28 @@ void MusicQuiz::QuizBoard::setQuizName(const QString& name)
 	_name = name;
 }
 
+void MusicQuiz::QuizBoard::setLatencyTracker(const common::LatencyTracker::Ptr& latencyTracker)
+{
+	_latencyTracker = latencyTracker;
+}
+
+void MusicQuiz::QuizBoard::writeLatencyReport()
+{
+	if ( _latencyTracker == nullptr ) {
+		return;
+	}
+
+	/** Written once per game, the tracker is cleared afterwards */
+	const std::string fileName = "./data/latency/latency_" + QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss").toStdString() + ".txt";
+	try {
+		_latencyTracker->writeFile(fileName, "Latency report of '" + _name.toStdString() + "'");
+		LOG_INFO("Latency report written to '" << fileName << "'.");
+	} catch ( const std::exception& err ) {
+		LOG_WARN("Failed to write the latency report. " << err.what());
+	}
+	_latencyTracker->clear();
+}
+
 QString MusicQuiz::QuizBoard::getQuizName()
 {
 	return _name;
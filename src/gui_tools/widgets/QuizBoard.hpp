@@ -11,6 +11,7 @@
 #include <QKeyEvent>
 
 #include "util/QuizSettings.hpp"
+#include "common/LatencyTracker.hpp"
 
 
 namespace MusicQuiz {
@@ -51,6 +52,13 @@ namespace MusicQuiz {
 		 */
 		void setQuizName(const QString& name);
 
+		/**
+		 * @brief Sets the tracker of the entry clicks, its report is written when the game ends.
+		 *
+		 * @param[in] latencyTracker The latency tracker.
+		 */
+		void setLatencyTracker(const common::LatencyTracker::Ptr& latencyTracker);
+
 		/**
 		 * @brief Get the quiz name.
 		 *
@@ -78,6 +86,12 @@ namespace MusicQuiz {
 		 */
 		void handleGameComplete();
 
+		/**
+		 * @brief Preloads the media of the entries that are likely to be played next. All idle entries are preloaded
+		 *        if they fit in the preload pool, otherwise the hovered entry and its neighbours are preloaded.
+		 */
+		void preloadEntries();
+
 		/**
 		 * @brief Handles the close event.
 		 *
@@ -110,6 +124,11 @@ namespace MusicQuiz {
 		 */
 		void createLayout();
 
+		/**
+		 * @brief Writes the latency report to ./data/latency/.
+		 */
+		void writeLatencyReport();
+
 		/** Variables */
 		bool _quizClosed = false;
 		bool _quizStopped = false;
@@ -121,5 +140,7 @@ namespace MusicQuiz {
 		std::vector<QuizTeam*> _teams;
 		std::vector<QString> _rowCategories;
 		std::vector<MusicQuiz::QuizCategory*> _categories;
+
+		common::LatencyTracker::Ptr _latencyTracker = nullptr;
 	};
 }
\ No newline at end of file
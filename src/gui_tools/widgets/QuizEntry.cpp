@@ -85,12 +85,26 @@ void MusicQuiz::QuizEntry::mouseReleaseEvent(QMouseEvent* event)
 
 void MusicQuiz::QuizEntry::handleMouseEvent(QMouseEvent* event)
 {
+	/** Only the clicks that start the audio player are traced, the trace ends when the audio is audible. The answer of a
+	    video is played with the audio of the video, which is not traced */
+	const bool startsAudio = _state == EntryState::IDLE || (_type == EntryType::Song && (_state == EntryState::PAUSED || _state == EntryState::PLAYED));
+	const bool traced = _latencyTracker != nullptr && event->button() == Qt::LeftButton && startsAudio;
+	if ( traced ) {
+		_latencyTracker->begin();
+	} else if ( _latencyTracker != nullptr ) {
+		_latencyTracker->end();
+	}
+
 	if ( event->button() == Qt::LeftButton ) {
 		leftClickEvent();
 	} else if ( event->button() == Qt::RightButton ) {
 		rightClickEvent();
 	}
 
+	if ( traced ) {
+		_latencyTracker->mark("click_handled");
+	}
+
 	/** Set Object Name (this changes the color) */
 	switch ( _state )
 	{
@@ -138,8 +152,13 @@ void MusicQuiz::QuizEntry::leftClickEvent()
 		} else if ( _type == EntryType::Video ) {
 			_audioPlayer->stop();
 			_videoPlayer->play(_videoFile, _videoStartTime, true);
-			_videoPlayer->show();
+			_videoPlayer->reveal();
 			_audioPlayer->play(_audioFile, _startTime);
+
+			/** The muted video follows the audio */
+			if ( _avSync != nullptr ) {
+				_avSync->start(_startTime, _videoStartTime);
+			}
 		}
 		break;
 	case EntryState::PLAYING: // Pause Media
@@ -155,8 +174,12 @@ void MusicQuiz::QuizEntry::leftClickEvent()
 		if ( _type == EntryType::Song ) {
 			_audioPlayer->play(_audioFile, _answerStartTime);
 		} else if ( _type == EntryType::Video ) {
+			/** The answer is played with the audio of the video */
+			if ( _avSync != nullptr ) {
+				_avSync->stop();
+			}
 			_videoPlayer->play(_videoFile, _answerStartTime);
-			_videoPlayer->show();
+			_videoPlayer->reveal();
 		}
 
 		if ( !_hiddenAnswer ) {
@@ -168,7 +191,7 @@ void MusicQuiz::QuizEntry::leftClickEvent()
 		_audioPlayer->stop();
 		if ( _videoPlayer != nullptr ) {
 			_videoPlayer->stop();
-			_videoPlayer->hide();
+			_videoPlayer->conceal();
 		}
 		break;
 	case QuizEntry::EntryState::PLAYED: // Play Answer Again
@@ -176,7 +199,7 @@ void MusicQuiz::QuizEntry::leftClickEvent()
 			_audioPlayer->play(_audioFile, _answerStartTime);
 		} else if ( _type == EntryType::Video ) {
 			_videoPlayer->play(_videoFile, _answerStartTime);
-			_videoPlayer->show();
+			_videoPlayer->reveal();
 		}
 		_state = EntryState::PLAYING_ANSWER;
 		break;
@@ -197,7 +220,7 @@ void MusicQuiz::QuizEntry::rightClickEvent()
 		_audioPlayer->pause();
 		if ( _videoPlayer != nullptr ) {
 			_videoPlayer->pause();
-			_videoPlayer->show();
+			_videoPlayer->reveal();
 		}
 		break;
 	case EntryState::PAUSED: // Continue playing
@@ -205,7 +228,7 @@ void MusicQuiz::QuizEntry::rightClickEvent()
 		_audioPlayer->resume();
 		if ( _videoPlayer != nullptr ) {
 			_videoPlayer->resume();
-			_videoPlayer->show();
+			_videoPlayer->reveal();
 		}
 		break;
 	case EntryState::PLAYING_ANSWER: // Pause Media
@@ -213,7 +236,7 @@ void MusicQuiz::QuizEntry::rightClickEvent()
 		_audioPlayer->pause();
 		if ( _videoPlayer != nullptr ) {
 			_videoPlayer->pause();
-			_videoPlayer->show();
+			_videoPlayer->reveal();
 		}
 		_fontSize = 40;
 		setText("$" + QString::fromLocal8Bit(std::to_string(_points).c_str()));
@@ -285,11 +308,48 @@ MusicQuiz::QuizEntry::EntryState MusicQuiz::QuizEntry::getEntryState()
 	return _state;
 }
 
+void MusicQuiz::QuizEntry::preload(const bool prerollVideo)
+{
+	switch ( _state )
+	{
+	case EntryState::IDLE: // Start Media
+		_audioPlayer->preload(_audioFile, _startTime);
+		if ( _type == EntryType::Video && prerollVideo ) {
+			_videoPlayer->preroll(_videoFile, _videoStartTime);
+		}
+		break;
+	case EntryState::PAUSED: // Play Answer
+	case EntryState::PLAYED: // Play Answer Again
+		if ( _type == EntryType::Song ) {
+			_audioPlayer->preload(_audioFile, _answerStartTime);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void MusicQuiz::QuizEntry::enterEvent(QEvent* event)
+{
+	emit hovered();
+	QPushButton::enterEvent(event);
+}
+
 void MusicQuiz::QuizEntry::setHiddenAnswer(bool hidden)
 {
 	_hiddenAnswer = hidden;
 }
 
+void MusicQuiz::QuizEntry::setLatencyTracker(const common::LatencyTracker::Ptr& latencyTracker)
+{
+	_latencyTracker = latencyTracker;
+}
+
+void MusicQuiz::QuizEntry::setAvSync(const media::AvSync::Ptr& avSync)
+{
+	_avSync = avSync;
+}
+
 void MusicQuiz::QuizEntry::setDoublePointsEnabled(bool enabled, bool hidden)
 {
 	_doublePoints = enabled;
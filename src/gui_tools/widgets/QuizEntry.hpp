@@ -11,6 +11,8 @@
 
 #include "media/AudioPlayer.hpp"
 #include "media/VideoPlayer.hpp"
+#include "media/AvSync.hpp"
+#include "common/LatencyTracker.hpp"
 
 #include "common/Log.hpp"
 class QMouseEvent;
@@ -84,6 +86,14 @@ namespace MusicQuiz {
 		 */
 		EntryState getEntryState();
 
+		/**
+		 * @brief Preloads the media that is played on the next left click, such that it starts without delay.
+		 *
+		 * @param[in] prerollVideo True to also preroll the video. The video player holds a single video, such that
+		 *                         only the hovered entry should preroll its video.
+		 */
+		void preload(bool prerollVideo);
+
 	public slots:
 		/**
 		 * @brief Sets the color of the button (used after the entry is answered).
@@ -99,6 +109,20 @@ namespace MusicQuiz {
 		 */
 		void setHiddenAnswer(bool hidden);
 
+		/**
+		 * @brief Sets the tracker the clicks on the entry start a trace in.
+		 *
+		 * @param[in] latencyTracker The latency tracker or nullptr to disable the tracking.
+		 */
+		void setLatencyTracker(const common::LatencyTracker::Ptr& latencyTracker);
+
+		/**
+		 * @brief Sets the engine that keeps the video of the question in sync with its audio.
+		 *
+		 * @param[in] avSync The sync engine or nullptr to play the video unsynchronized.
+		 */
+		void setAvSync(const media::AvSync::Ptr& avSync);
+
 		/**
 		 * @brief Enables / disables double points.
 		 *
@@ -118,8 +142,16 @@ namespace MusicQuiz {
 	signals:
 		void answered(size_t points);
 		void played();
+		void hovered();
 
 	protected:
+		/**
+		 * @brief Override the enter event, used to preload the media of the entries that are likely to be played next.
+		 *
+		 * @param[in] event The event.
+		 */
+		void enterEvent(QEvent* event) override;
+
 		/**
 		 * @brief Override the mouse release event.
 		 *
@@ -174,6 +206,8 @@ namespace MusicQuiz {
 		std::shared_ptr < media::VideoPlayer > _videoPlayer = nullptr;
 
 		std::function< void(QMouseEvent*) > _mouseEventCallback;
+		common::LatencyTracker::Ptr _latencyTracker = nullptr;
+		media::AvSync::Ptr _avSync = nullptr;
 
 		/** Settings */
 		bool _hiddenAnswer = false;
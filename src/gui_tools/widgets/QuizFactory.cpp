@@ -1,10 +1,13 @@
 #include "QuizFactory.hpp"
 
-#include <math.h>
-#include <time.h>
+#include <set>
+#include <chrono>
 #include <vector>
 #include <string>
 #include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <unordered_map>
 #include <stdlib.h>
 #include <stdexcept>
 
@@ -15,62 +18,150 @@
 #include <boost/property_tree/xml_parser.hpp>
 
 #include "common/Log.hpp"
+#include "common/HashUtil.hpp"
+#include "common/LatencyTracker.hpp"
 #include "common/TimeUtil.hpp"
+#include "util/QuizPack.hpp"
+#include "util/MediaStore.hpp"
+#include "util/ClipExtractor.hpp"
+#include "util/QuizBinary.hpp"
 #include "util/QuizLoader.hpp"
+#include "util/QuizDocument.hpp"
 #include "gui_tools/widgets/QuizEntry.hpp"
 #include "gui_tools/widgets/QuizCategory.hpp"
 #include "gui_tools/QuizCreator/EntryCreator.hpp"
 #include "gui_tools/QuizCreator/CategoryCreator.hpp"
 
 
-MusicQuiz::QuizBoard* MusicQuiz::QuizFactory::createQuiz(const std::string& quizName, const QuizSettings& settings, const media::AudioPlayer::Ptr& audioPlayer,
-	const media::VideoPlayer::Ptr& videoPlayer, const std::vector<MusicQuiz::QuizTeam*>& teams, bool preview, QWidget* parent)
-{
-	/** Get List of Quizzes */
-	std::vector<std::string> quizList = MusicQuiz::util::QuizLoader::getListOfQuizzes();
-	if ( quizList.empty() ) {
-		throw std::runtime_error("No quizzes found in the data folder.");
+namespace {
+	typedef std::chrono::steady_clock Clock;
+
+	/** A media file of an entry that is saved once all entries are valid */
+	struct MediaCopy
+	{
+		std::string source = "";
+		std::string target = "";
+		boost::property_tree::ptree* mediaTree = nullptr;
+		std::string field = "";
+		bool video = false;
+		bool clip = false;
+		size_t clipStart = 0;
+		size_t clipEnd = 0;
+	};
+
+	std::string getPartialFile(const std::string& file)
+	{
+		/** The extension is kept such that ffmpeg detects the format of a clip */
+		boost::filesystem::path path(file);
+		const std::string extension = path.extension().string();
+		return path.replace_extension(".partial" + extension).string();
+	}
+
+	bool isSavedMedia(const std::string& file, const std::string& target)
+	{
+		boost::system::error_code error;
+		return MusicQuiz::util::MediaStore::contains(file) || boost::filesystem::equivalent(file, target, error);
 	}
 
-	/** Check if Quiz Exists */
-	size_t idx = 0;
-	bool quizExists = false;
-	for ( size_t i = 0; i < quizList.size(); ++i ) {
-		std::replace(quizList[i].begin(), quizList[i].end(), '\\', '/');
-		if ( quizName == quizList[i] ) {
-			idx = i;
-			quizExists = true;
-			break;
+	bool isUnchanged(const std::string& source, const std::string& target)
+	{
+		boost::system::error_code error;
+		if ( !boost::filesystem::exists(target, error) ) {
+			return false;
 		}
+
+		if ( boost::filesystem::equivalent(source, target, error) ) {
+			return true;
+		}
+
+		if ( boost::filesystem::file_size(source) != boost::filesystem::file_size(target) ) {
+			return false;
+		}
+
+		/** Copies get the modification time of their source, the content decides if the times differ */
+		if ( boost::filesystem::last_write_time(source) == boost::filesystem::last_write_time(target) ) {
+			return true;
+		}
+		return common::HashUtil::hashFile(source) == common::HashUtil::hashFile(target);
 	}
 
-	/** Sanity Check */
-	if ( !quizExists ) {
-		throw std::runtime_error("Quiz does not exists.");
+	void extractClip(const MediaCopy& mediaCopy, const std::string& file)
+	{
+		if ( mediaCopy.video ) {
+			MusicQuiz::util::ClipExtractor::extractVideo(mediaCopy.source, file, mediaCopy.clipStart, mediaCopy.clipEnd);
+		} else {
+			MusicQuiz::util::ClipExtractor::extractAudio(mediaCopy.source, file, mediaCopy.clipStart, mediaCopy.clipEnd);
+		}
 	}
 
+	void removePartialFiles(const std::vector<MediaCopy>& mediaCopies)
+	{
+		boost::system::error_code error;
+		for ( const MediaCopy& mediaCopy : mediaCopies ) {
+			boost::filesystem::remove(getPartialFile(mediaCopy.target), error);
+		}
+	}
+
+	double getMilliseconds(const Clock::time_point& start, const Clock::time_point& end)
+	{
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	}
+}
+
+
+MusicQuiz::QuizBoard* MusicQuiz::QuizFactory::createQuiz(const std::string& quizName, const QuizSettings& settings, const media::AudioPlayer::Ptr& audioPlayer,
+	const media::VideoPlayer::Ptr& videoPlayer, const std::vector<MusicQuiz::QuizTeam*>& teams, bool preview, QWidget* parent)
+{
+	/** Find Quiz */
+	const std::string quizId = MusicQuiz::util::QuizLoader::getQuizId(quizName);
+
 	/** Create Quiz */
-	return createQuiz(idx, settings, audioPlayer, videoPlayer, teams, preview, parent);
+	return createQuizById(quizId, settings, audioPlayer, videoPlayer, teams, preview, parent);
 }
 
-MusicQuiz::QuizBoard* MusicQuiz::QuizFactory::createQuiz(const size_t idx, const QuizSettings& settings, const media::AudioPlayer::Ptr& audioPlayer,
+MusicQuiz::QuizBoard* MusicQuiz::QuizFactory::createQuizById(const std::string& quizId, const QuizSettings& settings, const media::AudioPlayer::Ptr& audioPlayer,
 	const media::VideoPlayer::Ptr& videoPlayer, const std::vector<MusicQuiz::QuizTeam*>& teams, bool preview, QWidget* parent)
 {
-	/** Seed Rand */
-	srand(time(NULL));
+	/** Load Quiz Model */
+	const MusicQuiz::util::QuizModel::CPtr model = MusicQuiz::util::QuizLoader::loadQuizModel(quizId, settings);
+
+	/** Create Quiz */
+	return createQuiz(model, settings, audioPlayer, videoPlayer, teams, preview, parent);
+}
+
+MusicQuiz::QuizBoard* MusicQuiz::QuizFactory::createQuiz(const MusicQuiz::util::QuizModel::CPtr& model, const QuizSettings& settings, const media::AudioPlayer::Ptr& audioPlayer,
+	const media::VideoPlayer::Ptr& videoPlayer, const std::vector<MusicQuiz::QuizTeam*>& teams, bool preview, QWidget* parent)
+{
+	/** Sanity Check */
+	if ( model == nullptr ) {
+		throw std::runtime_error("Can not create quiz. The quiz model is nullptr.");
+	}
 
 	/** Create Quiz Board */
 	MusicQuiz::QuizBoard* quizBoard = nullptr;
 
-	/** Load Categories */
-	std::string loadError;
-	std::vector<MusicQuiz::QuizCategory*> categories = MusicQuiz::util::QuizLoader::loadQuizCategories(idx, audioPlayer, videoPlayer, loadError);
-	if ( !loadError.empty() ) {
-		QMessageBox::information(nullptr, "Info", "Incomplete Quiz:\n\n" + QString::fromStdString(loadError));
+	/** Incomplete Quiz */
+	if ( !model->missingMedia.empty() ) {
+		std::ostringstream missingMedia;
+		missingMedia << model->missingMedia;
+		QMessageBox::information(nullptr, "Info", "Incomplete Quiz:\n\n" + QString::fromStdString(missingMedia.str()));
 	}
 
-	/** Load Row Categories */
-	std::vector< QString > rowCategories = MusicQuiz::util::QuizLoader::loadQuizRowCategories(idx);
+	/** Latency Tracker, traces the entry clicks until the audio is audible */
+	const common::LatencyTracker::Ptr latencyTracker = settings.latencyReport ? std::make_shared<common::LatencyTracker>() : nullptr;
+
+	/** Quiz Pack, the players read the packed media from the mapped pack */
+	if ( audioPlayer != nullptr ) {
+		audioPlayer->setQuizPack(model->quizPack);
+		audioPlayer->setLatencyTracker(latencyTracker);
+	}
+
+	if ( videoPlayer != nullptr ) {
+		videoPlayer->setQuizPack(model->quizPack);
+	}
+
+	/** Audio Video Sync, shared by the video entries */
+	const media::AvSync::Ptr avSync = audioPlayer != nullptr && videoPlayer != nullptr ? std::make_shared<media::AvSync>(audioPlayer, videoPlayer) : nullptr;
 
 	/** Hidden Team Score */
 	if ( settings.hiddenTeamScore ) {
@@ -79,93 +170,75 @@ MusicQuiz::QuizBoard* MusicQuiz::QuizFactory::createQuiz(const size_t idx, const
 		}
 	}
 
-	/** Get Number of Entries */
-	size_t numberOfEntries = 0;
-	for ( size_t i = 0; i < categories.size(); ++i ) {
-		numberOfEntries += categories[i]->getSize();
-	}
-
-	std::vector<size_t> entriesIndicies(numberOfEntries);
-	for ( size_t i = 0; i < numberOfEntries; ++i ) {
-		entriesIndicies[i] = i;
-	}
-
-	/** Get Daily Double Entries */
-	size_t dailyDoubleCount = std::floor(double(numberOfEntries * settings.dailyDoublePercentage) / 100.0);
-	std::vector<size_t> dailyDoubleSelectedElements;
-	if ( settings.dailyDouble && !teams.empty() ) {
-		/** Ensure that there is atleas one element if the setting is enabled */
-		if ( dailyDoubleCount == 0 ) {
-			dailyDoubleCount = 1;
+	/** The entry strings are interned by the model, such that each distinct string is converted once and shared */
+	std::unordered_map<const char*, QString> strings;
+	const auto toQString = [&strings](const std::string_view& str) {
+		const auto it = strings.find(str.data());
+		if ( it != strings.end() ) {
+			return it->second;
 		}
+		return strings.emplace(str.data(), QString::fromUtf8(str.data(), static_cast<int>(str.size()))).first->second;
+	};
+
+	/** Create Categories, the daily double and triple entries are selected by the loader and only used with teams */
+	std::vector<MusicQuiz::QuizCategory*> categories;
+	for ( const MusicQuiz::util::QuizModel::Category& category : model->categories ) {
+		std::vector<MusicQuiz::QuizEntry*> categoryEntries;
+		for ( const MusicQuiz::util::QuizModel::Entry& entry : category.entries ) {
+			const QString answer = toQString(entry.answer);
+			const QString songFile = toQString(entry.songFile);
+			MusicQuiz::QuizEntry* quizEntry = nullptr;
+			if ( entry.type == MusicQuiz::util::QuizModel::EntryType::SONG ) {
+				quizEntry = new MusicQuiz::QuizEntry(songFile, answer, entry.points, entry.songStartTime, entry.answerStartTime, audioPlayer);
+			} else {
+				const QString videoFile = toQString(entry.videoFile);
+				quizEntry = new MusicQuiz::QuizEntry(songFile, videoFile, answer, entry.points, entry.songStartTime, entry.videoStartTime, entry.answerStartTime,
+					audioPlayer, videoPlayer);
+				quizEntry->setAvSync(avSync);
+			}
 
-		/** Select Elements */
-		while ( dailyDoubleSelectedElements.size() < dailyDoubleCount && !entriesIndicies.empty() ) {
-			const size_t randomIdx = rand() % entriesIndicies.size();
-			dailyDoubleSelectedElements.push_back(entriesIndicies[randomIdx]);
-			entriesIndicies.erase(entriesIndicies.begin() + randomIdx);
-		}
-	}
+			/** Double Points */
+			if ( entry.doublePoints && settings.dailyDouble && !teams.empty() ) {
+				quizEntry->setDoublePointsEnabled(true, settings.dailyDoubleHidden);
+			}
 
-	/** Get Daily Triple Entries */
-	size_t dailyTripleCount = std::floor(double(numberOfEntries * settings.dailyTriplePercentage) / 100.0);
-	std::vector<size_t> dailyTripleSelectedElements;
-	if ( settings.dailyTriple && !teams.empty() ) {
-		/** Ensure that there is atleas one element if the setting is enabled */
-		if ( dailyTripleCount == 0 ) {
-			dailyTripleCount = 1;
-		}
+			/** Triple Points */
+			if ( entry.triplePoints && settings.dailyTriple && !teams.empty() ) {
+				quizEntry->setTriplePointsEnabled(true, settings.dailyTripleHidden);
+			}
 
-		/** Select Elements */
-		while ( dailyTripleSelectedElements.size() < dailyTripleCount && !entriesIndicies.empty() ) {
-			const size_t randomIdx = rand() % entriesIndicies.size();
-			dailyTripleSelectedElements.push_back(entriesIndicies[randomIdx]);
-			entriesIndicies.erase(entriesIndicies.begin() + randomIdx);
+			/** Hidden Answers */
+			quizEntry->setHiddenAnswer(settings.hiddenAnswers);
+			quizEntry->setLatencyTracker(latencyTracker);
+			categoryEntries.push_back(quizEntry);
 		}
-	}
 
-	/** Apply Settings */
-	size_t counter = 0;
-	for ( size_t i = 0; i < categories.size(); ++i ) {
+		MusicQuiz::QuizCategory* quizCategory = new MusicQuiz::QuizCategory(QString::fromStdString(category.name), categoryEntries);
 		if ( settings.guessTheCategory ) {
-			categories[i]->enableGuessTheCategory(settings.pointsPerCategory);
+			quizCategory->enableGuessTheCategory(settings.pointsPerCategory);
 		}
-		for ( size_t j = 0; j < categories[i]->getSize(); ++j ) {
-			MusicQuiz::QuizEntry* quizEntry = (*categories[i])[j];
-			if ( quizEntry != nullptr ) {
-				/** Double Points */
-				for ( size_t k = 0; k < dailyDoubleSelectedElements.size(); ++k ) {
-					if ( counter == dailyDoubleSelectedElements[k] ) {
-						quizEntry->setDoublePointsEnabled(true, settings.dailyDoubleHidden);
-					}
-
-				}
-
-				/** Triple Points */
-				for ( size_t k = 0; k < dailyTripleSelectedElements.size(); ++k ) {
-					if ( counter == dailyTripleSelectedElements[k] ) {
-						quizEntry->setTriplePointsEnabled(true, settings.dailyTripleHidden);
-					}
-
-				}
+		categories.push_back(quizCategory);
+	}
 
-				/** Hidden Answers */
-				quizEntry->setHiddenAnswer(settings.hiddenAnswers);
-			}
-			++counter;
-		}
+	/** Create Row Categories */
+	std::vector< QString > rowCategories;
+	for ( size_t i = 0; i < model->rowCategories.size(); ++i ) {
+		rowCategories.push_back(QString::fromStdString(model->rowCategories[i]));
 	}
 
 	/** Create Quiz */
 	quizBoard = new MusicQuiz::QuizBoard(categories, rowCategories, teams, settings, preview, parent);
+	quizBoard->setLatencyTracker(latencyTracker);
 
 	return quizBoard;
 }
 
 void MusicQuiz::QuizFactory::saveQuiz(const MusicQuiz::QuizCreator::QuizData& data, QWidget* parent)
 {
-	/** Tmp Folder */
+	/** Media Folder, the media files are only copied if they are new or changed */
 	std::string mediaDirectoryPath;
+	std::vector<MediaCopy> mediaCopies;
+	const Clock::time_point saveStart = Clock::now();
 
 	try {
 		/** Get Quiz Name */
@@ -208,12 +281,14 @@ void MusicQuiz::QuizFactory::saveQuiz(const MusicQuiz::QuizCreator::QuizData& da
 			}
 		}
 
-		/** Create Media Folder */
-		mediaDirectoryPath = quizPath + "/mediaTmp";
-		boost::filesystem::create_directory(mediaDirectoryPath, boost_err);
-		if ( boost_err ) {
-			QMessageBox::warning(parent, "Failed to Save Quiz", "Failed to create directory to save the media files in.");
-			return;
+		/** Media Folder */
+		mediaDirectoryPath = quizPath + "/media";
+
+		/** Clip Extraction, the media files are copied if ffmpeg is not available */
+		bool extractClips = data.extractClips;
+		if ( extractClips && !MusicQuiz::util::ClipExtractor::isAvailable() ) {
+			QMessageBox::warning(parent, "Clip Extraction", "ffmpeg was not found, the complete media files are copied instead of clips.");
+			extractClips = false;
 		}
 
 		/** Wirte Quiz to XML Parser */
@@ -247,7 +322,6 @@ void MusicQuiz::QuizFactory::saveQuiz(const MusicQuiz::QuizCreator::QuizData& da
 			const std::string categoryName = category->getName().toStdString();
 			if ( categoryName.empty() ) {
 				QMessageBox::warning(parent, "Failed to Save Quiz", "Failed to save quiz. All categories must have a name.");
-				deleteDirectory(mediaDirectoryPath);
 				return;
 			}
 
@@ -256,21 +330,12 @@ void MusicQuiz::QuizFactory::saveQuiz(const MusicQuiz::QuizCreator::QuizData& da
 				if ( j != i ) {
 					if ( categoryName == data.quizCategories[j]->getName().toStdString() ) {
 						QMessageBox::warning(parent, "Failed to Save Quiz", "Failed to save quiz. All categories must have a unique name.");
-						deleteDirectory(mediaDirectoryPath);
 						return;
 					}
 				}
 			}
 			category_tree.put("<xmlattr>.name", categoryName);
 
-			/** Create Category Folder */
-			boost::filesystem::create_directory(mediaDirectoryPath + "/" + categoryName, boost_err);
-			if ( boost_err ) {
-				QMessageBox::warning(parent, "Failed to Save Quiz", "Failed to create directory to save the catrgory files in.");
-				deleteDirectory(mediaDirectoryPath);
-				return;
-			}
-
 			/** Category Entries */
 			const std::vector< MusicQuiz::EntryCreator* > entries = category->getEntries();
 			const size_t numberOfEntries = entries.size();
@@ -285,7 +350,6 @@ void MusicQuiz::QuizFactory::saveQuiz(const MusicQuiz::QuizCreator::QuizData& da
 				const std::string entryName = entry->getName().toStdString();
 				if ( entryName.empty() ) {
 					QMessageBox::warning(parent, "Failed to Save Quiz", "Failed to save quiz. " + QString::fromStdString(categoryName) + ": All entries needs to have a name.");
-					deleteDirectory(mediaDirectoryPath);
 					return;
 				}
 				entry_tree.put("Answer", entryName);
@@ -295,7 +359,6 @@ void MusicQuiz::QuizFactory::saveQuiz(const MusicQuiz::QuizCreator::QuizData& da
 					if ( k != j ) {
 						if ( entryName == category->getEntries()[k]->getName().toStdString() ) {
 							QMessageBox::warning(parent, "Failed to Save Quiz", "Failed to save quiz. " + QString::fromStdString(categoryName) + ": All entires in a category must have a unique name.");
-							deleteDirectory(mediaDirectoryPath);
 							return;
 						}
 					}
@@ -315,49 +378,83 @@ void MusicQuiz::QuizFactory::saveQuiz(const MusicQuiz::QuizCreator::QuizData& da
 
 				/** Media */
 				if ( type == MusicQuiz::EntryCreator::EntryType::Song ) { // Song
+					/** Media File */
+					const std::string songFile = entry->getSongFile().toStdString();
+					const std::string songTarget = mediaDirectoryPath + "/" + categoryName + "/" + entryName + boost::filesystem::path(songFile).extension().string();
+					const size_t songStartTime = entry->getSongStartTime();
+					const size_t answerStartTime = entry->getAnswerStartTime();
+
+					/** Clip, the start times are relative to the start of the clip. A saved media file or clip is not clipped again */
+					const auto songClip = data.clips.find(songFile);
+					const bool savedClip = songClip != data.clips.end();
+					const bool clip = extractClips && !songFile.empty() && !savedClip && !isSavedMedia(songFile, songTarget);
+					const size_t clipStart = clip ? MusicQuiz::util::ClipExtractor::getClipStart({ songStartTime, answerStartTime }, data.clipPreRoll) : 0;
+					const size_t clipEnd = clip ? MusicQuiz::util::ClipExtractor::getClipEnd({ songStartTime, answerStartTime }, data.clipPostRoll) : 0;
+
 					/** Entry Song Start Time */
-					entry_tree.put("StartTime", entry->getSongStartTime());
+					entry_tree.put("StartTime", songStartTime - clipStart);
 
 					/** Entry Song Answer Start Time */
-					entry_tree.put("AnswerStartTime", entry->getAnswerStartTime());
+					entry_tree.put("AnswerStartTime", answerStartTime - clipStart);
 
-					/** Media File */
-					const std::string songFile = entry->getSongFile().toStdString();
 					if ( !songFile.empty() ) {
-						const std::string audioFileExtension = boost::filesystem::path(songFile).extension().string();
-						const std::string songPath = quizPath + "/media/" + categoryName + "/" + entryName + audioFileExtension;
 						boost::property_tree::ptree& media_tree = entry_tree.add("Media", "");
-						media_tree.put("SongFile", songPath);
+						media_tree.put("SongFile", songTarget);
+						if ( clip ) {
+							media_tree.put("<xmlattr>.clipOffset", clipStart);
+							media_tree.put("<xmlattr>.source", songFile);
+						} else if ( savedClip ) {
+							media_tree.put("<xmlattr>.clipOffset", songClip->second.offset);
+							media_tree.put("<xmlattr>.source", songClip->second.source);
+						}
 
-						/** Copy Media File */
-						boost::filesystem::copy_file(songFile, mediaDirectoryPath + "/" + categoryName + "/" + entryName + audioFileExtension, boost::filesystem::copy_option::overwrite_if_exists);
+						/** Copy Media File, once all entries are valid */
+						mediaCopies.push_back({ songFile, songTarget, &media_tree, "SongFile", false, clip, clipStart, clipEnd });
 					}
 				} else if ( type == MusicQuiz::EntryCreator::EntryType::Video ) { // Video
+					/** Media File */
+					const std::string videoFile = entry->getVideoFile().toStdString();
+					const std::string songFile = entry->getVideoSongFile().toStdString();
+					const std::string songTarget = mediaDirectoryPath + "/" + categoryName + "/" + entryName + "_song" + boost::filesystem::path(songFile).extension().string();
+					const size_t videoStartTime = entry->getVideoStartTime();
+					const size_t songStartTime = entry->getVideoSongStartTime();
+					const size_t answerStartTime = entry->getVideoAnswerStartTime();
+
+					/** Clip, the answer is played from both files such that they are clipped at the same offset */
+					const auto videoClip = data.clips.find(videoFile);
+					const auto songClip = data.clips.find(songFile);
+					const bool savedClip = videoClip != data.clips.end() && songClip != data.clips.end();
+					const bool clip = extractClips && !videoFile.empty() && !songFile.empty() && !savedClip && !isSavedMedia(songFile, songTarget);
+					const size_t clipStart = clip ? MusicQuiz::util::ClipExtractor::getClipStart({ videoStartTime, songStartTime, answerStartTime }, data.clipPreRoll) : 0;
+					const size_t clipEnd = clip ? MusicQuiz::util::ClipExtractor::getClipEnd({ videoStartTime, songStartTime, answerStartTime }, data.clipPostRoll) : 0;
+					const std::string videoTarget = mediaDirectoryPath + "/" + categoryName + "/" + entryName + "_video" + (clip ? ".mp4" : boost::filesystem::path(videoFile).extension().string());
+
 					/** Entry Video Start Time */
-					entry_tree.put("StartTime", entry->getVideoStartTime());
+					entry_tree.put("StartTime", videoStartTime - clipStart);
 
 					/** Entry Video Song Start Time */
-					entry_tree.put("VideoSongStartTime", entry->getVideoSongStartTime());
+					entry_tree.put("VideoSongStartTime", songStartTime - clipStart);
 
 					/** Entry Video Answer Start Time */
-					entry_tree.put("AnswerStartTime", entry->getVideoAnswerStartTime());
-
-					/** Media File */
-					const std::string videoFile = entry->getVideoFile().toStdString();
-					const std::string songFile = entry->getVideoSongFile().toStdString();
+					entry_tree.put("AnswerStartTime", answerStartTime - clipStart);
 
 					if ( !videoFile.empty() && !songFile.empty() ) {
-						const std::string videoFileExtension = boost::filesystem::path(videoFile).extension().string();
-						const std::string audioFileExtension = boost::filesystem::path(songFile).extension().string();
-						const std::string videoPath = quizPath + "/media/" + categoryName + "/" + entryName + "_video" + videoFileExtension;
-						const std::string songPath = quizPath + "/media/" + categoryName + "/" + entryName + "_song" + audioFileExtension;
 						boost::property_tree::ptree& media_tree = entry_tree.add("Media", "");
-						media_tree.put("VideoFile", videoPath);
-						media_tree.put("SongFile", songPath);
+						media_tree.put("VideoFile", videoTarget);
+						media_tree.put("SongFile", songTarget);
+						if ( clip ) {
+							media_tree.put("<xmlattr>.clipOffset", clipStart);
+							media_tree.put("<xmlattr>.videoSource", videoFile);
+							media_tree.put("<xmlattr>.source", songFile);
+						} else if ( savedClip ) {
+							media_tree.put("<xmlattr>.clipOffset", songClip->second.offset);
+							media_tree.put("<xmlattr>.videoSource", videoClip->second.source);
+							media_tree.put("<xmlattr>.source", songClip->second.source);
+						}
 
-						/** Copy Media File */
-						boost::filesystem::copy_file(videoFile, mediaDirectoryPath + "/" + categoryName + "/" + entryName + "_video" + videoFileExtension, boost::filesystem::copy_option::overwrite_if_exists);
-						boost::filesystem::copy_file(songFile, mediaDirectoryPath + "/" + categoryName + "/" + entryName + "_song" + audioFileExtension, boost::filesystem::copy_option::overwrite_if_exists);
+						/** Copy Media Files, once all entries are valid */
+						mediaCopies.push_back({ videoFile, videoTarget, &media_tree, "VideoFile", true, clip, clipStart, clipEnd });
+						mediaCopies.push_back({ songFile, songTarget, &media_tree, "SongFile", false, clip, clipStart, clipEnd });
 					}
 				}
 			}
@@ -369,20 +466,158 @@ void MusicQuiz::QuizFactory::saveQuiz(const MusicQuiz::QuizCreator::QuizData& da
 			main_tree.add("QuizRowCategories.RowCategory", data.quizRowCategories[i].toStdString());
 		}
 
-		/** Delete Previous Folder */
-		const boost::filesystem::path target(quizPath + "/media");
-		deleteDirectory(target);
+		/** Copy Media, every copy is made before any is renamed into place such that a media file of the quiz that
+		    is the source of another entry is read before it is replaced */
+		const Clock::time_point mediaStart = Clock::now();
+		size_t copiedFiles = 0;
+		size_t unchangedFiles = 0;
+		uintmax_t copiedBytes = 0;
+		std::set<std::string> targets;
+		std::vector< std::pair<std::string, std::string> > partialFiles;
+		std::set<std::string> storedFiles;
+		for ( const MediaCopy& mediaCopy : mediaCopies ) {
+			/** Shared Media, the store only copies content it does not contain */
+			if ( data.sharedMedia ) {
+				std::string file = mediaCopy.source;
+				if ( mediaCopy.clip ) {
+					boost::filesystem::create_directories(boost::filesystem::path(mediaCopy.target).parent_path());
+					file = getPartialFile(mediaCopy.target);
+					extractClip(mediaCopy, file);
+				}
+
+				bool alreadyStored = false;
+				const uintmax_t fileSize = boost::filesystem::file_size(file);
+				const std::string storedFile = MusicQuiz::util::MediaStore::add(file, mediaCopy.clip, MusicQuiz::util::MediaStore::getStoreDirectory(), alreadyStored);
+				mediaCopy.mediaTree->put(mediaCopy.field, storedFile);
+				storedFiles.insert(boost::filesystem::path(storedFile).filename().string());
+				if ( alreadyStored ) {
+					++unchangedFiles;
+				} else {
+					++copiedFiles;
+					copiedBytes += fileSize;
+				}
+				continue;
+			}
+
+			targets.insert(boost::filesystem::path(mediaCopy.target).lexically_normal().generic_string());
+			if ( !mediaCopy.clip && isUnchanged(mediaCopy.source, mediaCopy.target) ) {
+				++unchangedFiles;
+				continue;
+			}
+
+			const std::string partialFile = getPartialFile(mediaCopy.target);
+			boost::filesystem::create_directories(boost::filesystem::path(mediaCopy.target).parent_path());
+			if ( mediaCopy.clip ) {
+				extractClip(mediaCopy, partialFile);
+			} else {
+				boost::filesystem::copy_file(mediaCopy.source, partialFile, boost::filesystem::copy_option::overwrite_if_exists);
+				boost::filesystem::last_write_time(partialFile, boost::filesystem::last_write_time(mediaCopy.source));
+			}
+			partialFiles.emplace_back(partialFile, mediaCopy.target);
+			++copiedFiles;
+			copiedBytes += boost::filesystem::file_size(partialFile);
+		}
+
+		for ( const std::pair<std::string, std::string>& partialFile : partialFiles ) {
+			boost::filesystem::rename(partialFile.first, partialFile.second);
+		}
+
+		/** Remove the media files of removed and renamed entries, all media files if the media is shared */
+		size_t removedFiles = 0;
+		if ( boost::filesystem::is_directory(mediaDirectoryPath) ) {
+			std::vector<boost::filesystem::path> staleFiles;
+			for ( boost::filesystem::recursive_directory_iterator it(mediaDirectoryPath), end; it != end; ++it ) {
+				if ( boost::filesystem::is_regular_file(it->path()) && targets.count(it->path().lexically_normal().generic_string()) == 0 ) {
+					staleFiles.push_back(it->path());
+				}
+			}
+
+			for ( const boost::filesystem::path& staleFile : staleFiles ) {
+				boost::filesystem::remove(staleFile);
+				++removedFiles;
+			}
 
-		/** Rename tmp folder */
-		boost::filesystem::rename(mediaDirectoryPath, target);
+			for ( boost::filesystem::directory_iterator it(mediaDirectoryPath), end; it != end; ++it ) {
+				if ( boost::filesystem::is_directory(it->path()) && boost::filesystem::is_empty(it->path()) ) {
+					boost::filesystem::remove(it->path(), boost_err);
+				}
+			}
+
+			if ( boost::filesystem::is_empty(mediaDirectoryPath) ) {
+				boost::filesystem::remove(mediaDirectoryPath, boost_err);
+			}
+		}
+		const Clock::time_point mediaEnd = Clock::now();
 
-		/** Save Quiz */
+		/** Save Quiz, through a temporary file such that a failed save leaves the previous quiz intact */
 #if ( BOOST_VERSION >= 105600 )
 		boost::property_tree::xml_writer_settings<std::string> settings('\t', 1);
 #elif
 		boost::property_tree::xml_writer_settings<char> settings('\t', 1);
 #endif
-		boost::property_tree::write_xml(quizPath + "/" + quizName + ".quiz.xml", tree, std::locale(), settings);
+		const std::string quizFile = quizPath + "/" + quizName + ".quiz.xml";
+		const std::string previousHash = boost::filesystem::exists(quizFile) ? common::HashUtil::hashFile(quizFile) : "";
+
+		/** Shared Media of the previous version, nothing is released if it cannot be read */
+		std::set<std::string> releasedFiles;
+		if ( !previousHash.empty() ) {
+			try {
+				for ( const auto& reference : MusicQuiz::util::MediaStore::getReferenceCounts({ quizFile }) ) {
+					if ( storedFiles.count(reference.first) == 0 ) {
+						releasedFiles.insert(reference.first);
+					}
+				}
+			} catch ( const std::exception& err ) {
+				LOG_WARN("Failed to read the shared media of the previous version of quiz '" << quizFile << "'. " << err.what());
+			}
+		}
+		boost::property_tree::write_xml(quizFile + ".tmp", tree, std::locale(), settings);
+		boost::filesystem::rename(quizFile + ".tmp", quizFile);
+		const Clock::time_point xmlEnd = Clock::now();
+
+		/** Compile & Pack Quiz, the XML file and media folder remain the source of truth such that a failure is not fatal */
+		const std::string contentHash = common::HashUtil::hashFile(quizFile);
+		try {
+			const MusicQuiz::util::QuizDocument::CPtr document = MusicQuiz::util::QuizDocument::load(quizFile);
+			MusicQuiz::util::QuizBinary::write(*document, contentHash, MusicQuiz::util::QuizBinary::getBinaryFile(quizFile));
+		} catch ( const std::exception& err ) {
+			LOG_WARN("Failed to compile quiz '" << quizFile << "'. " << err.what());
+		}
+		const Clock::time_point compileEnd = Clock::now();
+
+		/** The pack is only written if enabled and again if the media changed, a pack that is not written is stale.
+		 *  Shared media is stored outside of the quiz folder and would leave the pack empty */
+		bool packUpdated = false;
+		try {
+			const std::string packFile = MusicQuiz::util::QuizPack::getPackFile(quizFile);
+			const bool mediaChanged = copiedFiles > 0 || removedFiles > 0;
+			if ( !data.writePack || data.sharedMedia ) {
+				boost::filesystem::remove(packFile);
+			} else {
+				packUpdated = !mediaChanged && MusicQuiz::util::QuizPack::updateSourceHash(packFile, previousHash, contentHash);
+				if ( !packUpdated ) {
+					MusicQuiz::util::QuizPack::write(quizPath, contentHash, packFile);
+				}
+			}
+		} catch ( const std::exception& err ) {
+			LOG_WARN("Failed to pack quiz '" << quizFile << "'. " << err.what());
+		}
+		const Clock::time_point packEnd = Clock::now();
+
+		LOG_INFO("Saved quiz '" << quizName << "' in " << getMilliseconds(saveStart, packEnd) << " ms. Media: " << copiedFiles << " copied ("
+			<< copiedBytes / (1024 * 1024) << " MB), " << unchangedFiles << " unchanged, " << removedFiles << " removed in "
+			<< getMilliseconds(mediaStart, mediaEnd) << " ms. XML: " << getMilliseconds(mediaEnd, xmlEnd) << " ms. Compile: "
+			<< getMilliseconds(xmlEnd, compileEnd) << " ms. Pack: " << getMilliseconds(compileEnd, packEnd) << " ms"
+			<< (packUpdated ? " (header only)." : "."));
+
+		/** Remove the shared media only the previous version of the quiz referenced */
+		try {
+			if ( !releasedFiles.empty() ) {
+				MusicQuiz::util::MediaStore::release(releasedFiles, MusicQuiz::util::QuizLoader::getListOfQuizzes());
+			}
+		} catch ( const std::exception& err ) {
+			LOG_WARN("Failed to remove unreferenced shared media. " << err.what());
+		}
 
 		/** Create Cheat Sheet */
 		std::ofstream cheatSheet(quizPath + "/" + quizName + ".cheatsheet.txt");
@@ -407,160 +642,150 @@ void MusicQuiz::QuizFactory::saveQuiz(const MusicQuiz::QuizCreator::QuizData& da
 		QMessageBox::information(parent, "Info", "Quiz saves successfully.");
 	} catch ( const std::exception& err ) {
 		QMessageBox::warning(parent, "Failed to Save Quiz", "Failed to save the quiz. " + QString::fromStdString(err.what()));
-		deleteDirectory(mediaDirectoryPath);
+		removePartialFiles(mediaCopies);
 	} catch ( ... ) {
 		QMessageBox::warning(parent, "Failed to Save Quiz", "Failed to save the quiz. Unkown Error.");
-		deleteDirectory(mediaDirectoryPath);
+		removePartialFiles(mediaCopies);
 	}
 }
 
 MusicQuiz::QuizCreator::QuizData MusicQuiz::QuizFactory::loadQuiz(const std::string& quizName, const media::AudioPlayer::Ptr& audioPlayer,
 	QWidget* parent)
 {
-	/** Get List of Quizzes */
-	std::vector<std::string> quizList = MusicQuiz::util::QuizLoader::getListOfQuizzes();
-	if ( quizList.empty() ) {
-		throw std::runtime_error("No quizzes found in the data folder.");
-	}
-
-	/** Check if Quiz Exists */
-	size_t idx = 0;
-	bool quizExists = false;
-	for ( size_t i = 0; i < quizList.size(); ++i ) {
-		std::replace(quizList[i].begin(), quizList[i].end(), '\\', '/');
-		if ( quizName == quizList[i] ) {
-			idx = i;
-			quizExists = true;
-			break;
-		}
-	}
-
-	/** Sanity Check */
-	if ( !quizExists ) {
-		throw std::runtime_error("Quiz does not exists.");
-	}
+	/** Find Quiz */
+	const std::string quizId = MusicQuiz::util::QuizLoader::getQuizId(quizName);
 
 	/** Quiz Data */
 	MusicQuiz::QuizCreator::QuizData data;
 
-	/** Load Categories */
-	boost::property_tree::ptree tree;
-	boost::property_tree::read_xml(quizList[idx], tree, boost::property_tree::xml_parser::trim_whitespace);
-	boost::property_tree::ptree sub_tree = tree.get_child("MusicQuiz");
+	/** Load Document */
+	const MusicQuiz::util::QuizDocument::CPtr document = MusicQuiz::util::QuizLoader::getQuizDocument(MusicQuiz::util::QuizLoader::getQuizFile(quizId));
+	if ( !document->missingFields.empty() ) {
+		throw std::runtime_error("No such node (" + document->missingFields.front() + ")");
+	}
 
 	/** Quiz Name */
-	boost::property_tree::ptree::const_iterator ini_ctrl = tree.begin();
-	data.quizName = QString::fromStdString(ini_ctrl->second.get<std::string>("QuizName"));
+	data.quizName = QString::fromStdString(document->quizName);
 
 	/** Quiz Author */
-	data.quizAuthor = QString::fromStdString(ini_ctrl->second.get<std::string>("QuizAuthor"));
+	data.quizAuthor = QString::fromStdString(document->quizAuthor);
 
 	/** Quiz Description */
-	data.quizDescription = QString::fromStdString(ini_ctrl->second.get<std::string>("QuizDescription"));
+	data.quizDescription = QString::fromStdString(document->quizDescription);
+
+	/** Quiz Pack */
+	data.writePack = boost::filesystem::exists(MusicQuiz::util::QuizPack::getPackFile(MusicQuiz::util::QuizLoader::getQuizFile(quizId)));
 
 	/** Hidden Categories */
-	data.guessTheCategory = ini_ctrl->second.get("QuizGuessTheCategory.<xmlattr>.enabled", false);
+	data.guessTheCategory = document->guessTheCategory;
 
 	/** Categories */
+	const boost::filesystem::path full_path(boost::filesystem::current_path());
 	std::vector< MusicQuiz::CategoryCreator* > categories;
-	boost::property_tree::ptree::const_iterator ctrl = sub_tree.begin();
-	for ( ; ctrl != sub_tree.end(); ++ctrl ) {
-		if ( ctrl->first == "QuizCategories" ) {
-			boost::property_tree::ptree categoriesTree = ctrl->second;
-			boost::property_tree::ptree::const_iterator sub_ctrl = categoriesTree.begin();
-			try {
-				for ( ; sub_ctrl != categoriesTree.end(); ++sub_ctrl ) {
-					if ( sub_ctrl->first == "Category" ) {
-						/** Category Name */
-						const QString categoryName = QString::fromStdString(sub_ctrl->second.get<std::string>("<xmlattr>.name"));
-
-						/** Category */
-						MusicQuiz::CategoryCreator* category = new MusicQuiz::CategoryCreator(categoryName, audioPlayer, parent);
-
-						/** Category Entries */
-						std::vector< MusicQuiz::EntryCreator* > categorieEntries;
-						boost::property_tree::ptree entryTree = sub_ctrl->second;
-						boost::property_tree::ptree::const_iterator it = entryTree.begin();
-						for ( ; it != entryTree.end(); ++it ) {
-							try {
-								if ( it->first == "QuizEntry" ) {
-									const boost::filesystem::path full_path(boost::filesystem::current_path());
-
-									/** Settings */
-									const QString entryName = QString::fromStdString(it->second.get<std::string>("<xmlattr>.name"));
-									const size_t points = it->second.get<size_t>("Points");
-
-									/** Quiz Entry */
-									MusicQuiz::EntryCreator* entry = new MusicQuiz::EntryCreator(entryName, points, audioPlayer, category);
-
-									/** Media Type */
-									const std::string type = it->second.get<std::string>("<xmlattr>.type");
-									if ( type == "song" ) { // Song
-										entry->setType(MusicQuiz::EntryCreator::EntryType::Song);
-
-										/** Start Time */
-										try {
-											entry->setSongStartTime(it->second.get<size_t>("StartTime"));
-										} catch ( ... ) {}
-
-										try {
-											entry->setAnswerStartTime(it->second.get<size_t>("AnswerStartTime"));
-										} catch ( ... ) {}
-
-										/** Song File */
-										try {
-											QString songFile = QString::fromStdString(full_path.string() + "/" + it->second.get<std::string>("Media.SongFile"));
-											std::replace(songFile.begin(), songFile.end(), '\\', '/');
-											entry->setSongFile(songFile);
-										} catch ( ... ) {}
-									} else if ( type == "video" ) { // Video
-										entry->setType(MusicQuiz::EntryCreator::EntryType::Video);
-
-										/** Song File */
-										try {
-											QString songFile = QString::fromStdString(full_path.string() + "/" + it->second.get<std::string>("Media.SongFile"));
-											std::replace(songFile.begin(), songFile.end(), '\\', '/');
-											entry->setVideoSongFile(songFile);
-										} catch ( ... ) {}
-
-										try {
-											entry->setVideoSongStartTime(it->second.get<size_t>("VideoSongStartTime"));
-										} catch ( ... ) {}
-
-										/** Video File */
-										try {
-											QString videoFile = QString::fromStdString(full_path.string() + "/" + it->second.get<std::string>("Media.VideoFile"));
-											std::replace(videoFile.begin(), videoFile.end(), '\\', '/');
-											entry->setVideoFile(videoFile);
-										} catch ( ... ) {}
-
-										try {
-											entry->setVideoStartTime(it->second.get<size_t>("StartTime"));
-										} catch ( ... ) {}
-
-										try {
-											entry->setVideoAnswerStartTime(it->second.get<size_t>("AnswerStartTime"));
-										} catch ( ... ) {}
-									}
-									categorieEntries.push_back(entry);
-								}
-							} catch ( ... ) {}
-						}
-						category->setEntries(categorieEntries);
-						categories.push_back(category);
+	for ( const MusicQuiz::util::QuizDocument::Category& documentCategory : document->categories ) {
+		/** Category Name */
+		const QString categoryName = QString::fromStdString(documentCategory.name);
+
+		/** Category */
+		MusicQuiz::CategoryCreator* category = new MusicQuiz::CategoryCreator(categoryName, audioPlayer, parent);
+
+		/** Category Entries */
+		std::vector< MusicQuiz::EntryCreator* > categorieEntries;
+		for ( const MusicQuiz::util::QuizDocument::Entry& documentEntry : documentCategory.entries ) {
+			/** Entries without a name or points are skipped */
+			if ( !documentEntry.hasField("<xmlattr>.name") || !documentEntry.hasField("Points") ) {
+				continue;
+			}
+
+			/** Shared Media */
+			if ( !documentEntry.songFile.empty() && MusicQuiz::util::MediaStore::contains(documentEntry.songFile) ) {
+				data.sharedMedia = true;
+			}
+
+			/** Settings */
+			const QString entryName = QString::fromStdString(documentEntry.name);
+			const size_t points = documentEntry.points;
+
+			/** Quiz Entry */
+			MusicQuiz::EntryCreator* entry = new MusicQuiz::EntryCreator(entryName, points, audioPlayer, category);
+
+			/** Media Type */
+			if ( documentEntry.type == "song" ) { // Song
+				entry->setType(MusicQuiz::EntryCreator::EntryType::Song);
+
+				/** Start Time */
+				if ( documentEntry.hasField("StartTime") ) {
+					entry->setSongStartTime(documentEntry.startTime);
+				}
+
+				if ( documentEntry.hasField("AnswerStartTime") ) {
+					entry->setAnswerStartTime(documentEntry.answerStartTime);
+				}
+
+				/** Song File */
+				if ( documentEntry.hasField("Media.SongFile") ) {
+					QString songFile = QString::fromStdString(full_path.string() + "/" + documentEntry.songFile);
+					std::replace(songFile.begin(), songFile.end(), '\\', '/');
+					entry->setSongFile(songFile);
+
+					/** Clip */
+					if ( !documentEntry.songSource.empty() ) {
+						data.clips[songFile.toStdString()] = { documentEntry.clipOffset, documentEntry.songSource };
 					}
 				}
-			} catch ( const std::exception& err ) {
-				LOG_ERROR("Failed to load quiz. " << err.what());
-			} catch ( ... ) {
-				LOG_ERROR("Failed to load quiz.");
+			} else if ( documentEntry.type == "video" ) { // Video
+				entry->setType(MusicQuiz::EntryCreator::EntryType::Video);
+
+				/** Song File */
+				if ( documentEntry.hasField("Media.SongFile") ) {
+					QString songFile = QString::fromStdString(full_path.string() + "/" + documentEntry.songFile);
+					std::replace(songFile.begin(), songFile.end(), '\\', '/');
+					entry->setVideoSongFile(songFile);
+
+					/** Clip */
+					if ( !documentEntry.songSource.empty() ) {
+						data.clips[songFile.toStdString()] = { documentEntry.clipOffset, documentEntry.songSource };
+					}
+				}
+
+				if ( documentEntry.hasField("VideoSongStartTime") ) {
+					entry->setVideoSongStartTime(documentEntry.videoSongStartTime);
+				}
+
+				/** Video File */
+				if ( documentEntry.hasField("Media.VideoFile") ) {
+					QString videoFile = QString::fromStdString(full_path.string() + "/" + documentEntry.videoFile);
+					std::replace(videoFile.begin(), videoFile.end(), '\\', '/');
+					entry->setVideoFile(videoFile);
+
+					/** Clip */
+					if ( !documentEntry.videoSource.empty() ) {
+						data.clips[videoFile.toStdString()] = { documentEntry.clipOffset, documentEntry.videoSource };
+					}
+				}
+
+				if ( documentEntry.hasField("StartTime") ) {
+					entry->setVideoStartTime(documentEntry.startTime);
+				}
+
+				if ( documentEntry.hasField("AnswerStartTime") ) {
+					entry->setVideoAnswerStartTime(documentEntry.answerStartTime);
+				}
 			}
+			categorieEntries.push_back(entry);
 		}
+		category->setEntries(categorieEntries);
+		categories.push_back(category);
 	}
 	data.quizCategories = categories;
 
-	/** Load Row Categories */
-	data.quizRowCategories = MusicQuiz::util::QuizLoader::loadQuizRowCategories(idx);
+	/** Clip Extraction, enabled if the quiz contains clips */
+	data.extractClips = !data.clips.empty();
+
+	/** Row Categories */
+	for ( size_t i = 0; i < document->rowCategories.size(); ++i ) {
+		data.quizRowCategories.push_back(QString::fromStdString(document->rowCategories[i]));
+	}
 
 	/** Return */
 	return data;
@@ -7,6 +7,7 @@
 
 #include <boost/filesystem.hpp>
 
+#include "util/QuizModel.hpp"
 #include "util/QuizSettings.hpp"
 #include "media/AudioPlayer.hpp"
 #include "media/VideoPlayer.hpp"
@@ -54,7 +55,7 @@ namespace MusicQuiz {
 		/**
 		 * @brief Creates the music quiz.
 		 *
-		 * @param[in] idx The quiz index to load.
+		 * @param[in] quizId The id of the quiz to load.
 		 * @param[in] settings The quiz settings.
 		 * @param[in] audioPlayer The audio player.
 		 * @param[in] videoPlayer The video player
@@ -64,7 +65,23 @@ namespace MusicQuiz {
 		 *
 		 * @return The quiz board.
 		 */
-		static MusicQuiz::QuizBoard* createQuiz(const size_t idx, const MusicQuiz::QuizSettings& settings, const std::shared_ptr< media::AudioPlayer >& audioPlayer,
+		static MusicQuiz::QuizBoard* createQuizById(const std::string& quizId, const MusicQuiz::QuizSettings& settings, const std::shared_ptr< media::AudioPlayer >& audioPlayer,
+			const std::shared_ptr< media::VideoPlayer >& videoPlayer, const std::vector<MusicQuiz::QuizTeam*>& teams = {}, bool preview = false, QWidget* parent = nullptr);
+
+		/**
+		 * @brief Creates the music quiz widgets from a loaded quiz model.
+		 *
+		 * @param[in] model The quiz model.
+		 * @param[in] settings The quiz settings.
+		 * @param[in] audioPlayer The audio player.
+		 * @param[in] videoPlayer The video player
+		 * @param[in] teams The teams list.
+		 * @param[in] preview If the quiz should be displayed in preview mode.
+		 * @param[in] parent The quiz board parent.
+		 *
+		 * @return The quiz board.
+		 */
+		static MusicQuiz::QuizBoard* createQuiz(const MusicQuiz::util::QuizModel::CPtr& model, const MusicQuiz::QuizSettings& settings, const std::shared_ptr< media::AudioPlayer >& audioPlayer,
 			const std::shared_ptr< media::VideoPlayer >& videoPlayer, const std::vector<MusicQuiz::QuizTeam*>& teams = {}, bool preview = false, QWidget* parent = nullptr);
 
 		/**
@@ -26,7 +26,7 @@ MusicQuiz::QuizSettingsDialog::QuizSettingsDialog(const MusicQuiz::QuizSettings&
 
 	/** Set Size */
 	const size_t width = 400;
-	const size_t height = 425;
+	const size_t height = 535;
 	if ( parent == nullptr ) {
 		resize(width, height);
 	} else {
@@ -71,6 +71,48 @@ void MusicQuiz::QuizSettingsDialog::createLayout(const MusicQuiz::QuizSettings&
 	hiddenAnswersLayout->addWidget(infoBtn);
 	mainlayout->addItem(hiddenAnswersLayout);
 
+	/** Latency Report */
+	QHBoxLayout* latencyReportLayout = new QHBoxLayout;
+	latencyReportLayout->setSpacing(5);
+	_latencyReport = new QCheckBox("Latency Report");
+	_latencyReport->setObjectName("settingsCheckbox");
+	_latencyReport->setChecked(settings.latencyReport);
+	latencyReportLayout->addWidget(_latencyReport);
+
+	infoBtn = new QPushButton;
+	infoBtn->setObjectName("settingsInfo");
+	connect(infoBtn, SIGNAL(released()), this, SLOT(showLatencyReportInfo()));
+	latencyReportLayout->addWidget(infoBtn);
+	mainlayout->addItem(latencyReportLayout);
+
+	/** Stage Media */
+	QHBoxLayout* stageMediaLayout = new QHBoxLayout;
+	stageMediaLayout->setSpacing(5);
+	_stageMedia = new QCheckBox("Stage Media");
+	_stageMedia->setObjectName("settingsCheckbox");
+	_stageMedia->setChecked(settings.stageMedia);
+	stageMediaLayout->addWidget(_stageMedia);
+
+	infoBtn = new QPushButton;
+	infoBtn->setObjectName("settingsInfo");
+	connect(infoBtn, SIGNAL(released()), this, SLOT(showStageMediaInfo()));
+	stageMediaLayout->addWidget(infoBtn);
+	mainlayout->addItem(stageMediaLayout);
+
+	/** Prefetch Media */
+	QHBoxLayout* prefetchMediaLayout = new QHBoxLayout;
+	prefetchMediaLayout->setSpacing(5);
+	_prefetchMedia = new QCheckBox("Prefetch Media");
+	_prefetchMedia->setObjectName("settingsCheckbox");
+	_prefetchMedia->setChecked(settings.prefetchMedia);
+	prefetchMediaLayout->addWidget(_prefetchMedia);
+
+	infoBtn = new QPushButton;
+	infoBtn->setObjectName("settingsInfo");
+	connect(infoBtn, SIGNAL(released()), this, SLOT(showPrefetchMediaInfo()));
+	prefetchMediaLayout->addWidget(infoBtn);
+	mainlayout->addItem(prefetchMediaLayout);
+
 	/** Line */
 	QFrame* line = new QFrame;
 	line->setObjectName("settingsLine");
@@ -314,6 +356,15 @@ void MusicQuiz::QuizSettingsDialog::saveSettings()
 	/** Hidden Teams */
 	settings.hiddenTeamScore = _hiddenTeam->isChecked();
 
+	/** Latency Report */
+	settings.latencyReport = _latencyReport->isChecked();
+
+	/** Stage Media */
+	settings.stageMedia = _stageMedia->isChecked();
+
+	/** Prefetch Media */
+	settings.prefetchMedia = _prefetchMedia->isChecked();
+
 	/** Daily Double */
 	settings.dailyDouble = _dailyDouble->isChecked();
 	settings.dailyDoubleHidden = _dailyDoubleHidden->isChecked();
@@ -368,6 +419,21 @@ void MusicQuiz::QuizSettingsDialog::showHiddenAnswersInfo()
 	informationMessageBox("If enabled the quiz answers will be hidden after the song have been guessed.");
 }
 
+void MusicQuiz::QuizSettingsDialog::showLatencyReportInfo()
+{
+	informationMessageBox("If enabled the time from clicking an entry until the song is heard is measured. A report is written to ./data/latency/ when the game ends.");
+}
+
+void MusicQuiz::QuizSettingsDialog::showStageMediaInfo()
+{
+	informationMessageBox("If enabled the media of the quiz is copied to ./data/.staging/ before the quiz starts, such that it is not played from a slow or removable drive. The least recently used media is removed when the copies exceed 8 GB.");
+}
+
+void MusicQuiz::QuizSettingsDialog::showPrefetchMediaInfo()
+{
+	informationMessageBox("If enabled the media of the selected quiz is read in the background at up to 16 MB/s, such that it is cached by the system when played. Disable it if the quizzes are on a shared or slow drive.");
+}
+
 void MusicQuiz::QuizSettingsDialog::showDailyDoubleInfo()
 {
 	informationMessageBox("If enabled the set percentage of entries will give double points. The entries are choosen randomly.");
@@ -103,6 +103,9 @@ namespace MusicQuiz {
 		void showDailyTripleInfo();
 		void showDailyDoubleHiddenInfo();
 		void showDailyTripleHiddenInfo();
+		void showLatencyReportInfo();
+		void showStageMediaInfo();
+		void showPrefetchMediaInfo();
 
 	signals:
 		void quitSignal();
@@ -144,6 +147,9 @@ namespace MusicQuiz {
 		/** Variables */
 		QCheckBox* _hiddenTeam = nullptr;
 		QCheckBox* _hiddenAnswers = nullptr;
+		QCheckBox* _latencyReport = nullptr;
+		QCheckBox* _stageMedia = nullptr;
+		QCheckBox* _prefetchMedia = nullptr;
 
 		/** Daily Double */
 		QCheckBox* _dailyDouble = nullptr;
@@ -1,5 +1,7 @@
 #include "AudioPlayer.hpp"
 
+#include <cstdlib>
+#include <utility>
 #include <stdexcept>
 
 #include <QVBoxLayout>
@@ -8,18 +10,33 @@
 #include "common/Log.hpp"
 
 
+namespace {
+	/** Number of players kept open and positioned for the entries that are likely to be played next */
+	constexpr size_t PRELOAD_CAPACITY = 8;
+
+	/** Interval of the position updates in milliseconds, the start position is confirmed by the first update */
+	constexpr int POSITION_NOTIFY_INTERVAL = 20;
+
+	/** Maximum distance between the requested and the achieved start position in milliseconds */
+	constexpr qint64 START_POSITION_TOLERANCE = 250;
+
+	/** Number of times a seek that landed outside the tolerance is repeated */
+	constexpr size_t MAX_SEEK_RETRIES = 2;
+}
+
+
 media::AudioPlayer::AudioPlayer(QWidget* parent) :
 	QWidget(parent)
 {
 	/** Create Media Player */
-	_player = new QMediaPlayer(this);
-	_player->setVolume(100);
+	_player = createPlayer();
 }
 
 media::AudioPlayer::~AudioPlayer()
 {
 	/** Stop Audio */
 	_player->stop();
+	_player->setMedia(QMediaContent());
 }
 
 void media::AudioPlayer::play(const QString& audioFile)
@@ -29,13 +46,17 @@ void media::AudioPlayer::play(const QString& audioFile)
 		throw std::runtime_error("Video File Name is empty.");
 	}
 
-	/** Stop audio if any is playing and close file */
+	/** Stop audio if any is playing, the file is kept open */
 	stop();
+	_startTimer.start();
+	_requestedPosition = 0;
+	_seekRetries = 0;
 
-	/** Set Audio File */
-	_player->setMedia(QUrl::fromLocalFile(audioFile));
+	/** Set Audio File, muted until the position is confirmed */
+	load(audioFile, 0);
+	_player->setMuted(true);
 
-	/** Play Video */
+	/** Play Audio */
 	_player->play();
 
 	/** Set State */
@@ -49,14 +70,16 @@ void media::AudioPlayer::play(const QString& audioFile, const size_t startTime)
 		throw std::runtime_error("Video File Name is empty.");
 	}
 
-	/** Stop audio if any is playing and close file */
+	/** Stop audio if any is playing, the file is kept open */
 	stop();
+	_startTimer.start();
+	_requestedPosition = static_cast<qint64>(startTime);
+	_seekRetries = 0;
+	markLatency("play");
 
-	/** Set Audio File */
-	_player->setMedia(QUrl::fromLocalFile(audioFile));
-
-	/** Set Start Time */
-	_player->setPosition(startTime);
+	/** Set Audio File, muted until the position is confirmed */
+	load(audioFile, startTime);
+	_player->setMuted(true);
 
 	/** Play Audio */
 	_player->play();
@@ -72,7 +95,7 @@ void media::AudioPlayer::pause()
 		return;
 	}
 
-	/** Pause Video */
+	/** Pause Audio */
 	_player->pause();
 
 	/** Set State */
@@ -95,10 +118,261 @@ void media::AudioPlayer::resume()
 
 void media::AudioPlayer::stop()
 {
-	/** Stop Video */
-	_player->stop();
-	_player->setMedia(QMediaContent());
+	/** Pause rather than stop, the media stays loaded and prerolled such that playing the same file again only seeks */
+	_player->pause();
+	_player->setMuted(false);
+	_requestedPosition = -1;
 
 	/** Set State */
 	_state = AudioPlayState::IDLE;
+}
+
+void media::AudioPlayer::releaseMedia()
+{
+	stop();
+	unload();
+	clearPreloaded();
+}
+
+void media::AudioPlayer::setQuizPack(const MusicQuiz::util::QuizPack::CPtr& quizPack)
+{
+	/** The loaded and preloaded media might be read from the previous pack */
+	releaseMedia();
+	_quizPack = quizPack;
+}
+
+void media::AudioPlayer::setLatencyTracker(const common::LatencyTracker::Ptr& latencyTracker)
+{
+	_latencyTracker = latencyTracker;
+}
+
+qint64 media::AudioPlayer::getPosition() const
+{
+	return _player->position();
+}
+
+bool media::AudioPlayer::isAudible() const
+{
+	return _state == AudioPlayState::PLAYING && _requestedPosition < 0;
+}
+
+void media::AudioPlayer::preload(const QString& audioFile, const size_t startTime)
+{
+	/** Sanity Check */
+	if ( audioFile.isEmpty() ) {
+		return;
+	}
+
+	/** Already Preloaded */
+	for ( auto it = _preloaded.begin(); it != _preloaded.end(); ++it ) {
+		if ( it->audioFile == audioFile && it->startTime == startTime ) {
+			_preloaded.splice(_preloaded.begin(), _preloaded, it);
+			return;
+		}
+	}
+
+	/** Player, unused players and once the pool is full the least recently used player are reused */
+	PreloadedPlayer preloaded;
+	if ( !_preloaded.empty() && (_preloaded.size() >= PRELOAD_CAPACITY || _preloaded.back().audioFile.isEmpty()) ) {
+		preloaded = _preloaded.back();
+		_preloaded.pop_back();
+		release(preloaded);
+	} else {
+		preloaded.player = createPlayer();
+	}
+
+	/** Open the media and seek such that play only has to start the playback */
+	preloaded.device = setMedia(preloaded.player, audioFile);
+	seek(preloaded.player, startTime);
+	preloaded.audioFile = audioFile;
+	preloaded.startTime = startTime;
+	_preloaded.push_front(preloaded);
+}
+
+void media::AudioPlayer::clearPreloaded()
+{
+	for ( PreloadedPlayer& preloaded : _preloaded ) {
+		release(preloaded);
+	}
+}
+
+size_t media::AudioPlayer::getPreloadCapacity()
+{
+	return PRELOAD_CAPACITY;
+}
+
+void media::AudioPlayer::mediaStatusChanged(const QMediaPlayer::MediaStatus status)
+{
+	QMediaPlayer* player = qobject_cast<QMediaPlayer*>(sender());
+	if ( player == _player && _requestedPosition >= 0 && (status == QMediaPlayer::LoadedMedia || status == QMediaPlayer::BufferedMedia) ) {
+		markLatency("media_loaded");
+	}
+
+	const auto it = _pendingSeeks.find(player);
+	if ( it == _pendingSeeks.end() ) {
+		return;
+	}
+
+	/** Apply the seek once the media is loaded */
+	if ( status == QMediaPlayer::LoadedMedia || status == QMediaPlayer::BufferedMedia ) {
+		player->setPosition(it->second);
+		_pendingSeeks.erase(it);
+	} else if ( status == QMediaPlayer::InvalidMedia || status == QMediaPlayer::NoMedia ) {
+		_pendingSeeks.erase(it);
+	}
+}
+
+void media::AudioPlayer::positionChanged(const qint64 position)
+{
+	/** Only the start of the active player is confirmed, once its seek is applied and it is playing */
+	if ( sender() != _player || _requestedPosition < 0 || _pendingSeeks.count(_player) != 0 || _player->state() != QMediaPlayer::PlayingState ) {
+		return;
+	}
+
+	markLatency("position_advanced");
+
+	/** Repeat a seek that was dropped or landed late */
+	if ( std::abs(position - _requestedPosition) > START_POSITION_TOLERANCE && _seekRetries < MAX_SEEK_RETRIES ) {
+		++_seekRetries;
+		_player->setPosition(_requestedPosition);
+		return;
+	}
+
+	_player->setMuted(false);
+	reportStart(position);
+}
+
+void media::AudioPlayer::playerStateChanged(const QMediaPlayer::State state)
+{
+	if ( sender() == _player && _requestedPosition >= 0 && state == QMediaPlayer::PlayingState ) {
+		markLatency("player_playing");
+	}
+}
+
+QMediaPlayer* media::AudioPlayer::createPlayer()
+{
+	QMediaPlayer* player = new QMediaPlayer(this);
+	player->setVolume(100);
+	player->setNotifyInterval(POSITION_NOTIFY_INTERVAL);
+	connect(player, SIGNAL(mediaStatusChanged(QMediaPlayer::MediaStatus)), this, SLOT(mediaStatusChanged(QMediaPlayer::MediaStatus)));
+	connect(player, SIGNAL(positionChanged(qint64)), this, SLOT(positionChanged(qint64)));
+	connect(player, SIGNAL(stateChanged(QMediaPlayer::State)), this, SLOT(playerStateChanged(QMediaPlayer::State)));
+	return player;
+}
+
+void media::AudioPlayer::seek(QMediaPlayer* player, const size_t position)
+{
+	/** A seek before the media is loaded can be dropped by the backend */
+	const QMediaPlayer::MediaStatus status = player->mediaStatus();
+	if ( status == QMediaPlayer::LoadedMedia || status == QMediaPlayer::BufferingMedia || status == QMediaPlayer::BufferedMedia ||
+		status == QMediaPlayer::EndOfMedia ) {
+		_pendingSeeks.erase(player);
+		player->setPosition(position);
+	} else {
+		_pendingSeeks[player] = position;
+	}
+}
+
+void media::AudioPlayer::reportStart(const qint64 achievedPosition)
+{
+	const qint64 timeToAudible = _startTimer.elapsed();
+	const qint64 requestedPosition = _requestedPosition;
+	_requestedPosition = -1;
+
+	LOG_DEBUG("Audio started at " << achievedPosition << " ms, requested " << requestedPosition << " ms, audible after " << timeToAudible << " ms.");
+	markLatency("audible");
+	if ( _latencyTracker != nullptr ) {
+		_latencyTracker->end();
+	}
+	emit audible(requestedPosition, achievedPosition, timeToAudible);
+}
+
+void media::AudioPlayer::markLatency(const std::string& stage)
+{
+	if ( _latencyTracker != nullptr ) {
+		_latencyTracker->mark(stage);
+	}
+}
+
+void media::AudioPlayer::load(const QString& audioFile, const size_t startTime)
+{
+	/** Preloaded player, already opened and positioned */
+	if ( activatePreloaded(audioFile, startTime) ) {
+		return;
+	}
+
+	/** Same file, only seek such that the demuxer and decoder are kept */
+	if ( audioFile == _mediaFile && _player->mediaStatus() != QMediaPlayer::InvalidMedia ) {
+		seek(_player, startTime);
+		return;
+	}
+
+	/** Open File */
+	unload();
+	_mediaDevice = setMedia(_player, audioFile);
+	_mediaFile = audioFile;
+	seek(_player, startTime);
+}
+
+void media::AudioPlayer::unload()
+{
+	_pendingSeeks.erase(_player);
+	_player->setMedia(QMediaContent());
+	_mediaFile = "";
+
+	/** Close the device of the previous media */
+	if ( _mediaDevice != nullptr ) {
+		_mediaDevice->deleteLater();
+		_mediaDevice = nullptr;
+	}
+}
+
+bool media::AudioPlayer::activatePreloaded(const QString& audioFile, const size_t startTime)
+{
+	for ( auto it = _preloaded.begin(); it != _preloaded.end(); ++it ) {
+		if ( it->audioFile != audioFile || it->startTime != startTime ) {
+			continue;
+		}
+
+		/** Swap the stopped player into the pool, it is reused first */
+		std::swap(_player, it->player);
+		std::swap(_mediaDevice, it->device);
+		_mediaFile = audioFile;
+		it->audioFile = "";
+		it->startTime = 0;
+		_preloaded.splice(_preloaded.end(), _preloaded, it);
+		return true;
+	}
+
+	return false;
+}
+
+void media::AudioPlayer::release(PreloadedPlayer& preloaded)
+{
+	_pendingSeeks.erase(preloaded.player);
+	preloaded.player->stop();
+	preloaded.player->setMedia(QMediaContent());
+	if ( preloaded.device != nullptr ) {
+		preloaded.device->deleteLater();
+		preloaded.device = nullptr;
+	}
+	preloaded.audioFile = "";
+	preloaded.startTime = 0;
+}
+
+QIODevice* media::AudioPlayer::setMedia(QMediaPlayer* player, const QString& mediaFile)
+{
+	/** Quiz Pack */
+	if ( _quizPack != nullptr ) {
+		QIODevice* device = _quizPack->createDevice(mediaFile.toStdString(), this);
+		if ( device != nullptr ) {
+			/** The file name is only used as a hint for the media format */
+			player->setMedia(QUrl::fromLocalFile(mediaFile), device);
+			return device;
+		}
+	}
+
+	/** Media File */
+	player->setMedia(QUrl::fromLocalFile(mediaFile));
+	return nullptr;
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <list>
 #include <memory>
+#include <unordered_map>
 
 #include <QString>
 #include <QWidget>
@@ -9,6 +11,10 @@
 #include <QMouseEvent>
 #include <QMediaPlayer>
 #include <QVideoWidget>
+#include <QElapsedTimer>
+
+#include "util/QuizPack.hpp"
+#include "common/LatencyTracker.hpp"
 
 
 namespace media {
@@ -75,10 +81,189 @@ namespace media {
 		 * @brief Stops the audio.
 		 */
 		void stop();
+
+		/**
+		 * @brief Stops the audio and closes the loaded and preloaded media files, such that they can be replaced or
+		 *        removed.
+		 */
+		void releaseMedia();
+
+		/**
+		 * @brief Sets the pack the media is read from. Files that are not in the pack are read from disk.
+		 *
+		 * @param[in] quizPack The quiz pack or nullptr to read all media from disk.
+		 */
+		void setQuizPack(const MusicQuiz::util::QuizPack::CPtr& quizPack);
+
+		/**
+		 * @brief Opens an audio file in a pooled player and seeks to the start time, such that a later call to play
+		 *        with the same file and start time starts immediately. The least recently preloaded file is closed if
+		 *        the pool is full.
+		 *
+		 * @param[in] audioFile The name of the audio file.
+		 * @param[in] startTime The time at which the audio file will be played from.
+		 */
+		void preload(const QString& audioFile, size_t startTime);
+
+		/**
+		 * @brief Closes all preloaded audio files.
+		 */
+		void clearPreloaded();
+
+		/**
+		 * @brief Returns the number of audio files that can be preloaded at the same time.
+		 *
+		 * @return The number of audio files.
+		 */
+		static size_t getPreloadCapacity();
+
+		/**
+		 * @brief Sets the tracker the stages of starting the playback are marked in.
+		 *
+		 * @param[in] latencyTracker The latency tracker or nullptr to disable the tracking.
+		 */
+		void setLatencyTracker(const common::LatencyTracker::Ptr& latencyTracker);
+
+		/**
+		 * @brief Returns the position of the audio that is playing.
+		 *
+		 * @return The position in milliseconds.
+		 */
+		qint64 getPosition() const;
+
+		/**
+		 * @brief Returns true if the audio is playing and its start position has been confirmed.
+		 *
+		 * @return True if the audio is audible.
+		 */
+		bool isAudible() const;
+	signals:
+		/**
+		 * @brief Emitted when a started audio file becomes audible at a confirmed position.
+		 *
+		 * @param[in] requestedPosition The position the audio file was requested to start from in milliseconds.
+		 * @param[in] achievedPosition The position the audio file became audible at in milliseconds.
+		 * @param[in] timeToAudible The time from the call to play until the audio became audible in milliseconds.
+		 */
+		void audible(qint64 requestedPosition, qint64 achievedPosition, qint64 timeToAudible);
+	protected slots:
+		/**
+		 * @brief Applies the pending seek of a player once its media is loaded.
+		 *
+		 * @param[in] status The media status of the player.
+		 */
+		void mediaStatusChanged(QMediaPlayer::MediaStatus status);
+
+		/**
+		 * @brief Marks the start of the playback of the active player.
+		 *
+		 * @param[in] state The state of the player.
+		 */
+		void playerStateChanged(QMediaPlayer::State state);
+
+		/**
+		 * @brief Confirms the start position of the active player and unmutes it.
+		 *
+		 * @param[in] position The position of the player.
+		 */
+		void positionChanged(qint64 position);
 	protected:
+		struct PreloadedPlayer
+		{
+			QMediaPlayer* player = nullptr;
+			QIODevice* device = nullptr;
+			QString audioFile = "";
+			size_t startTime = 0;
+		};
+
+		/**
+		 * @brief Creates a player.
+		 *
+		 * @return The player.
+		 */
+		QMediaPlayer* createPlayer();
+
+		/**
+		 * @brief Seeks a player, the seek is postponed until the media is loaded.
+		 *
+		 * @param[in] player The player.
+		 * @param[in] position The position in milliseconds.
+		 */
+		void seek(QMediaPlayer* player, size_t position);
+
+		/**
+		 * @brief Reports the start of the playback.
+		 *
+		 * @param[in] achievedPosition The position the audio became audible at.
+		 */
+		void reportStart(qint64 achievedPosition);
+
+		/**
+		 * @brief Marks a stage of starting the playback in the latency tracker.
+		 *
+		 * @param[in] stage The stage.
+		 */
+		void markLatency(const std::string& stage);
+
+		/**
+		 * @brief Loads an audio file in the active player and seeks to the start time. A preloaded player is used if
+		 *        one is positioned at the start time, the loaded file is only sought if it is the same file.
+		 *
+		 * @param[in] audioFile The name of the audio file.
+		 * @param[in] startTime The time at which the audio file will be played from.
+		 */
+		void load(const QString& audioFile, size_t startTime);
+
+		/**
+		 * @brief Unloads the media of the active player and closes its device.
+		 */
+		void unload();
+
+		/**
+		 * @brief Makes a preloaded player the active player.
+		 *
+		 * @param[in] audioFile The name of the audio file.
+		 * @param[in] startTime The time at which to start playing the audio file from.
+		 *
+		 * @return True if the audio file was preloaded.
+		 */
+		bool activatePreloaded(const QString& audioFile, size_t startTime);
+
+		/**
+		 * @brief Closes the media of a preloaded player.
+		 *
+		 * @param[in] preloaded The preloaded player.
+		 */
+		void release(PreloadedPlayer& preloaded);
+
+		/**
+		 * @brief Sets the media of a player, read from the quiz pack if it contains the file.
+		 *
+		 * @param[in] player The player.
+		 * @param[in] mediaFile The media file.
+		 *
+		 * @return The device the media is read from or nullptr if it is read from disk.
+		 */
+		QIODevice* setMedia(QMediaPlayer* player, const QString& mediaFile);
 
 		/** Variables */
 		QMediaPlayer* _player = nullptr;
 		AudioPlayState _state = AudioPlayState::IDLE;
+
+		MusicQuiz::util::QuizPack::CPtr _quizPack = nullptr;
+		QIODevice* _mediaDevice = nullptr;
+		QString _mediaFile = "";
+
+		/** Preloaded players, the most recently preloaded first */
+		std::list<PreloadedPlayer> _preloaded;
+
+		/** Seeks that are applied once the media of the player is loaded */
+		std::unordered_map<const QMediaPlayer*, size_t> _pendingSeeks;
+
+		/** Start of the playback, the active player is muted until its position is confirmed */
+		QElapsedTimer _startTimer;
+		qint64 _requestedPosition = -1;
+		size_t _seekRetries = 0;
+		common::LatencyTracker::Ptr _latencyTracker = nullptr;
 	};
 }
\ No newline at end of file
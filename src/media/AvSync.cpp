@@ -0,0 +1,124 @@
+#include "AvSync.hpp"
+
+#include <cstdlib>
+#include <algorithm>
+
+#include "common/Log.hpp"
+
+
+namespace {
+	/** Interval between the comparisons of the positions in milliseconds */
+	constexpr int UPDATE_INTERVAL = 200;
+
+	/** Drift below which the video plays at normal rate and above which the rate is nudged in milliseconds */
+	constexpr qint64 IN_SYNC_THRESHOLD = 20;
+	constexpr qint64 NUDGE_THRESHOLD = 40;
+
+	/** Drift above which the video is sought to the audio position in milliseconds */
+	constexpr qint64 SEEK_THRESHOLD = 500;
+
+	/** The rate is chosen such that the drift is corrected within this time in milliseconds */
+	constexpr double CORRECTION_TIME = 2000.0;
+
+	/** Maximum deviation of the playback rate from the normal rate, larger nudges are audible in some backends */
+	constexpr double MAX_RATE_DEVIATION = 0.1;
+
+	/** Minimum change of the playback rate, changing the rate can cost a flush in some backends */
+	constexpr double MIN_RATE_CHANGE = 0.01;
+
+	/** Number of comparisons skipped after a seek */
+	constexpr size_t SEEK_SETTLE_UPDATES = 3;
+}
+
+
+media::AvSync::AvSync(const AudioPlayer::Ptr& audioPlayer, const VideoPlayer::Ptr& videoPlayer, QObject* parent) :
+	QObject(parent), _audioPlayer(audioPlayer), _videoPlayer(videoPlayer)
+{
+	_timer = new QTimer(this);
+	_timer->setInterval(UPDATE_INTERVAL);
+	connect(_timer, SIGNAL(timeout()), this, SLOT(update()));
+}
+
+void media::AvSync::start(const size_t audioStartTime, const size_t videoStartTime)
+{
+	_audioStartTime = static_cast<qint64>(audioStartTime);
+	_videoStartTime = static_cast<qint64>(videoStartTime);
+	_settleUpdates = 0;
+	setVideoRate(1.0);
+	_timer->start();
+}
+
+void media::AvSync::stop()
+{
+	if ( !_timer->isActive() ) {
+		return;
+	}
+
+	_timer->stop();
+	setVideoRate(1.0);
+	LOG_DEBUG("Audio video sync: " << _statistics);
+}
+
+const media::AvSync::Statistics& media::AvSync::getStatistics() const
+{
+	return _statistics;
+}
+
+void media::AvSync::resetStatistics()
+{
+	_statistics = Statistics();
+}
+
+void media::AvSync::update()
+{
+	/** Both players have to be playing, the audio position is only reliable once it is audible */
+	if ( !_audioPlayer->isAudible() || !_videoPlayer->isPlaying() ) {
+		return;
+	}
+
+	if ( _settleUpdates > 0 ) {
+		--_settleUpdates;
+		return;
+	}
+
+	/** Drift */
+	const qint64 audioPosition = _audioPlayer->getPosition() - _audioStartTime;
+	const qint64 videoPosition = _videoPlayer->getPosition() - _videoStartTime;
+	const qint64 drift = videoPosition - audioPosition;
+	const qint64 absoluteDrift = std::abs(drift);
+
+	++_statistics.samples;
+	const double samples = static_cast<double>(_statistics.samples);
+	_statistics.meanDrift += (static_cast<double>(drift) - _statistics.meanDrift) / samples;
+	_statistics.meanAbsoluteDrift += (static_cast<double>(absoluteDrift) - _statistics.meanAbsoluteDrift) / samples;
+	_statistics.maxAbsoluteDrift = std::max(_statistics.maxAbsoluteDrift, absoluteDrift);
+	emit driftMeasured(drift);
+
+	/** Seek, the drift is too large to be corrected by the rate */
+	if ( absoluteDrift > SEEK_THRESHOLD ) {
+		_videoPlayer->seek(_videoStartTime + audioPosition);
+		setVideoRate(1.0);
+		_settleUpdates = SEEK_SETTLE_UPDATES;
+		++_statistics.seeks;
+		return;
+	}
+
+	/** Nudge the rate, with hysteresis such that the rate is not changed back and forth around the threshold */
+	if ( absoluteDrift > NUDGE_THRESHOLD ) {
+		const double deviation = std::clamp(static_cast<double>(drift) / CORRECTION_TIME, -MAX_RATE_DEVIATION, MAX_RATE_DEVIATION);
+		setVideoRate(1.0 - deviation);
+	} else if ( absoluteDrift < IN_SYNC_THRESHOLD ) {
+		setVideoRate(1.0);
+	}
+}
+
+void media::AvSync::setVideoRate(const double rate)
+{
+	if ( std::abs(rate - _videoRate) < MIN_RATE_CHANGE && (rate != 1.0 || _videoRate == 1.0) ) {
+		return;
+	}
+
+	_videoRate = rate;
+	_videoPlayer->setPlaybackRate(rate);
+	++_statistics.rateChanges;
+}
\ No newline at end of file
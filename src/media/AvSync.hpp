@@ -0,0 +1,130 @@
+#pragma once
+
+#include <memory>
+#include <cstddef>
+#include <ostream>
+
+#include <QTimer>
+#include <QObject>
+
+#include "media/AudioPlayer.hpp"
+#include "media/VideoPlayer.hpp"
+
+
+namespace media {
+	/**
+	 * @brief Keeps a muted video in sync with the audio file played along with it.
+	 *
+	 * The audio is the master clock. The positions are compared periodically, a small drift is corrected by nudging the
+	 * playback rate of the video and a large drift by seeking the video to the position of the audio.
+	 */
+	class AvSync : public QObject
+	{
+		Q_OBJECT
+	public:
+		struct Statistics
+		{
+			size_t samples = 0;
+			double meanDrift = 0.0;
+			double meanAbsoluteDrift = 0.0;
+			qint64 maxAbsoluteDrift = 0;
+			size_t rateChanges = 0;
+			size_t seeks = 0;
+
+			friend std::ostream& operator<<(std::ostream& os, const Statistics& statistics)
+			{
+				os << statistics.samples << " samples, mean drift " << statistics.meanDrift << " ms, mean absolute drift "
+					<< statistics.meanAbsoluteDrift << " ms, max absolute drift " << statistics.maxAbsoluteDrift << " ms, "
+					<< statistics.rateChanges << " rate changes, " << statistics.seeks << " seeks";
+				return os;
+			}
+		};
+
+		/**
+		 * @brief Shared Pointer
+		 */
+		typedef std::shared_ptr< AvSync > Ptr;
+
+		/**
+		 * @brief Constructor
+		 *
+		 * @param[in] audioPlayer The audio player used as the clock.
+		 * @param[in] videoPlayer The video player that follows the audio.
+		 * @param[in] parent The parent.
+		 */
+		explicit AvSync(const AudioPlayer::Ptr& audioPlayer, const VideoPlayer::Ptr& videoPlayer, QObject* parent = nullptr);
+
+		/**
+		 * @brief Destructor
+		 */
+		virtual ~AvSync() = default;
+
+		/**
+		 * @brief Deleted the copy and assignment constructor.
+		 */
+		AvSync(const AvSync&) = delete;
+		AvSync& operator=(const AvSync&) = delete;
+
+		/**
+		 * @brief Starts synchronizing the players. The video position videoStartTime corresponds to the audio position
+		 *        audioStartTime.
+		 *
+		 * @param[in] audioStartTime The start time of the audio in milliseconds.
+		 * @param[in] videoStartTime The start time of the video in milliseconds.
+		 */
+		void start(size_t audioStartTime, size_t videoStartTime);
+
+		/**
+		 * @brief Stops synchronizing the players and restores the playback rate of the video.
+		 */
+		void stop();
+
+		/**
+		 * @brief Returns the drift statistics since the last reset.
+		 *
+		 * @return The statistics.
+		 */
+		const Statistics& getStatistics() const;
+
+		/**
+		 * @brief Resets the drift statistics.
+		 */
+		void resetStatistics();
+
+	signals:
+		/**
+		 * @brief Emitted for every comparison of the positions.
+		 *
+		 * @param[in] drift The position of the video relative to the audio in milliseconds, positive if the video is ahead.
+		 */
+		void driftMeasured(qint64 drift);
+
+	protected slots:
+		/**
+		 * @brief Compares the positions and corrects the video.
+		 */
+		void update();
+
+	protected:
+		/**
+		 * @brief Sets the playback rate of the video if it differs noticeably from the current rate.
+		 *
+		 * @param[in] rate The playback rate.
+		 */
+		void setVideoRate(double rate);
+
+		/** Variables */
+		AudioPlayer::Ptr _audioPlayer = nullptr;
+		VideoPlayer::Ptr _videoPlayer = nullptr;
+		QTimer* _timer = nullptr;
+
+		qint64 _audioStartTime = 0;
+		qint64 _videoStartTime = 0;
+		double _videoRate = 1.0;
+
+		/** Comparisons are skipped until the video has settled after a seek */
+		size_t _settleUpdates = 0;
+
+		Statistics _statistics;
+	};
+}
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include <stdexcept>
 
+#include <QPalette>
+#include <QGuiApplication>
 #include <QVBoxLayout>
 #include <QMediaContent>
 
@@ -21,12 +23,14 @@ media::VideoPlayer::VideoPlayer(QWidget* parent) :
 	_player = new QMediaPlayer(this);
 	_player->setVideoOutput(_videoWidget);
 	_player->setVolume(100);
+	connect(_player, SIGNAL(mediaStatusChanged(QMediaPlayer::MediaStatus)), this, SLOT(mediaStatusChanged(QMediaPlayer::MediaStatus)));
 }
 
 media::VideoPlayer::~VideoPlayer()
 {
 	/** Stop Video */
 	_player->stop();
+	_player->setMedia(QMediaContent());
 }
 
 void media::VideoPlayer::play(const QString& videoFile, bool muted)
@@ -36,11 +40,11 @@ void media::VideoPlayer::play(const QString& videoFile, bool muted)
 		throw std::runtime_error("Video File Name is empty.");
 	}
 
-	/** Stop audio if any is playing and close file */
+	/** Stop video if any is playing, the file is kept open */
 	stop();
 
 	/** Set Video File */
-	_player->setMedia(QUrl::fromLocalFile(videoFile));
+	load(videoFile, 0);
 
 	/** Set Volume */
 	if ( muted ) {
@@ -63,11 +67,11 @@ void media::VideoPlayer::play(const QString& videoFile, const size_t startTime,
 		throw std::runtime_error("Video File Name is empty.");
 	}
 
-	/** Stop video if any is playing and close file */
+	/** Stop video if any is playing, the file is kept open */
 	stop();
 
 	/** Set Video File */
-	_player->setMedia(QUrl::fromLocalFile(videoFile));
+	load(videoFile, startTime);
 
 	/** Set Volume */
 	if ( muted ) {
@@ -76,9 +80,6 @@ void media::VideoPlayer::play(const QString& videoFile, const size_t startTime,
 		_player->setVolume(100);
 	}
 
-	/** Set Start Time */
-	_player->setPosition(startTime);
-
 	/** Play Video */
 	_player->play();
 
@@ -116,14 +117,20 @@ void media::VideoPlayer::resume()
 
 void media::VideoPlayer::stop()
 {
-	/** Stop Video */
-	_player->stop();
-	_player->setMedia(QMediaContent());
+	/** Pause rather than stop, the media stays loaded and prerolled such that playing the same file again only seeks */
+	_player->pause();
+	_player->setPlaybackRate(1.0);
 
 	/** Set State */
 	_state = VideoPlayState::IDLE;
 }
 
+void media::VideoPlayer::releaseMedia()
+{
+	stop();
+	unload();
+}
+
 void media::VideoPlayer::resize(const QSize& size)
 {
 	/** Resize the video widget */
@@ -144,7 +151,7 @@ void media::VideoPlayer::keyPressEvent(QKeyEvent* event)
 {
 	/** Hide Video if esc is pressed */
 	if ( event->key() == Qt::Key_Escape ) {
-		hide();
+		conceal();
 	}
 
 	event->accept();
@@ -153,4 +160,193 @@ void media::VideoPlayer::keyPressEvent(QKeyEvent* event)
 void media::VideoPlayer::setMouseEventCallbackFunction(const std::function< void(QMouseEvent*) > mouseEventCallback)
 {
 	_mouseEventCallback = mouseEventCallback;
+}
+
+void media::VideoPlayer::setQuizPack(const MusicQuiz::util::QuizPack::CPtr& quizPack)
+{
+	/** The loaded media might be read from the previous pack */
+	stop();
+	unload();
+	_quizPack = quizPack;
+}
+
+qint64 media::VideoPlayer::getPosition() const
+{
+	return _player->position();
+}
+
+void media::VideoPlayer::seek(const qint64 position)
+{
+	/** A seek before the media is loaded can be dropped by the backend */
+	const QMediaPlayer::MediaStatus status = _player->mediaStatus();
+	if ( status == QMediaPlayer::LoadedMedia || status == QMediaPlayer::BufferingMedia || status == QMediaPlayer::BufferedMedia ||
+		status == QMediaPlayer::EndOfMedia ) {
+		_pendingSeek = -1;
+		_player->setPosition(position);
+	} else {
+		_pendingSeek = position;
+	}
+}
+
+void media::VideoPlayer::setPlaybackRate(const double rate)
+{
+	_player->setPlaybackRate(rate);
+}
+
+bool media::VideoPlayer::isPlaying() const
+{
+	return _state == VideoPlayState::PLAYING && _player->state() == QMediaPlayer::PlayingState;
+}
+
+void media::VideoPlayer::setWarmSurface(const bool enabled)
+{
+	if ( enabled == _warmSurface ) {
+		return;
+	}
+
+	if ( enabled ) {
+		/** Wayland does not support the opacity and stacking of windows, the window is shown and hidden instead */
+		if ( QGuiApplication::platformName().startsWith("wayland") ) {
+			LOG_INFO("The video surface is not kept warm on '" << QGuiApplication::platformName().toStdString() << "'.");
+			return;
+		}
+
+		/** Black between videos */
+		QPalette palette = this->palette();
+		palette.setColor(QPalette::Window, Qt::black);
+		setPalette(palette);
+		setAutoFillBackground(true);
+
+		/** Map the window once, a window that stays on top cannot be lowered below the quiz board */
+		_warmSurface = true;
+		setWindowFlags(windowFlags() & ~Qt::WindowStaysOnTopHint);
+		setWindowOpacity(0.0);
+		show();
+		conceal();
+	} else {
+		_warmSurface = false;
+		_concealed = false;
+		_revealPending = false;
+		hide();
+		setWindowOpacity(1.0);
+	}
+}
+
+void media::VideoPlayer::reveal()
+{
+	if ( !_warmSurface ) {
+		show();
+		return;
+	}
+
+	if ( !isVisible() ) {
+		show();
+	}
+
+	/** Wait for a frame of the current video, the surface still holds the last frame of the previous video */
+	if ( !_frameReady && _state != VideoPlayState::IDLE ) {
+		_revealPending = true;
+		return;
+	}
+
+	_revealPending = false;
+	_concealed = false;
+	setWindowOpacity(1.0);
+	raise();
+	activateWindow();
+}
+
+void media::VideoPlayer::conceal()
+{
+	if ( !_warmSurface ) {
+		hide();
+		return;
+	}
+
+	/** Transparent and lowered rather than hidden, unmapping the window tears down the video sink */
+	_revealPending = false;
+	_concealed = true;
+	setWindowOpacity(0.0);
+	lower();
+}
+
+void media::VideoPlayer::preroll(const QString& videoFile, const size_t startTime)
+{
+	/** Only while the surface is concealed and not used by another video */
+	if ( !_warmSurface || !_concealed || _state != VideoPlayState::IDLE || videoFile.isEmpty() ) {
+		return;
+	}
+
+	load(videoFile, startTime);
+	_player->setVolume(0);
+	_player->pause();
+}
+
+void media::VideoPlayer::mediaStatusChanged(const QMediaPlayer::MediaStatus status)
+{
+	/** Apply the seek once the media is loaded */
+	if ( _pendingSeek >= 0 ) {
+		if ( status == QMediaPlayer::LoadedMedia || status == QMediaPlayer::BufferedMedia ) {
+			_player->setPosition(_pendingSeek);
+			_pendingSeek = -1;
+		} else if ( status == QMediaPlayer::InvalidMedia || status == QMediaPlayer::NoMedia ) {
+			_pendingSeek = -1;
+		}
+	}
+
+	if ( status != QMediaPlayer::BufferedMedia ) {
+		return;
+	}
+
+	_frameReady = true;
+	if ( _revealPending ) {
+		reveal();
+	}
+}
+
+void media::VideoPlayer::load(const QString& videoFile, const size_t startTime)
+{
+	/** Same file, only seek such that the demuxer and decoder are kept. A prerolled video is already positioned */
+	if ( videoFile == _mediaFile && _player->mediaStatus() != QMediaPlayer::InvalidMedia ) {
+		if ( _pendingSeek >= 0 || _player->position() != static_cast<qint64>(startTime) ) {
+			seek(startTime);
+		}
+		return;
+	}
+
+	/** Open File */
+	unload();
+	setMedia(videoFile);
+	_mediaFile = videoFile;
+	seek(startTime);
+}
+
+void media::VideoPlayer::unload()
+{
+	_player->setMedia(QMediaContent());
+	_mediaFile = "";
+	_frameReady = false;
+	_pendingSeek = -1;
+
+	/** Close the device of the previous media */
+	if ( _mediaDevice != nullptr ) {
+		_mediaDevice->deleteLater();
+		_mediaDevice = nullptr;
+	}
+}
+
+void media::VideoPlayer::setMedia(const QString& mediaFile)
+{
+	/** Quiz Pack */
+	if ( _quizPack != nullptr ) {
+		_mediaDevice = _quizPack->createDevice(mediaFile.toStdString(), this);
+		if ( _mediaDevice != nullptr ) {
+			/** The file name is only used as a hint for the media format */
+			_player->setMedia(QUrl::fromLocalFile(mediaFile), _mediaDevice);
+			return;
+		}
+	}
+
+	/** Media File */
+	_player->setMedia(QUrl::fromLocalFile(mediaFile));
 }
\ No newline at end of file
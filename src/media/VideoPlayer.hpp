@@ -10,6 +10,8 @@
 #include <QMediaPlayer>
 #include <QVideoWidget>
 
+#include "util/QuizPack.hpp"
+
 
 
 namespace media {
@@ -79,6 +81,11 @@ namespace media {
 		 */
 		void stop();
 
+		/**
+		 * @brief Stops the video and closes the loaded media file, such that it can be replaced or removed.
+		 */
+		void releaseMedia();
+
 		/**
 		 * @brief Resize the widget.
 		 *
@@ -92,7 +99,98 @@ namespace media {
 		 * @param[in] mouseEventCallback The callback function.
 		 */
 		void setMouseEventCallbackFunction(const std::function< void(QMouseEvent*) > mouseEventCallback);
+
+		/**
+		 * @brief Sets the pack the media is read from. Files that are not in the pack are read from disk.
+		 *
+		 * @param[in] quizPack The quiz pack or nullptr to read all media from disk.
+		 */
+		void setQuizPack(const MusicQuiz::util::QuizPack::CPtr& quizPack);
+
+		/**
+		 * @brief Returns the position of the video.
+		 *
+		 * @return The position in milliseconds.
+		 */
+		qint64 getPosition() const;
+
+		/**
+		 * @brief Seeks the video. A seek before the media is loaded is applied once it is loaded.
+		 *
+		 * @param[in] position The position in milliseconds.
+		 */
+		void seek(qint64 position);
+
+		/**
+		 * @brief Sets the playback rate of the video, the rate is restored to normal when the video is stopped.
+		 *
+		 * @param[in] rate The playback rate, 1.0 is normal speed.
+		 */
+		void setPlaybackRate(double rate);
+
+		/**
+		 * @brief Returns true if the video is playing.
+		 *
+		 * @return True if the video is playing.
+		 */
+		bool isPlaying() const;
+
+		/**
+		 * @brief Keeps the window mapped with its video sink set up between videos. The window is made transparent
+		 *        and lowered instead of being hidden, it no longer stays on top. Not supported on Wayland.
+		 *
+		 * @param[in] enabled True to keep the surface warm.
+		 */
+		void setWarmSurface(bool enabled);
+
+		/**
+		 * @brief Shows the video. A warm surface is made opaque and raised once a frame of the current video is available,
+		 *        such that the frame of a previous video is never shown.
+		 */
+		void reveal();
+
+		/**
+		 * @brief Hides the video. A warm surface is made transparent and lowered.
+		 */
+		void conceal();
+
+		/**
+		 * @brief Loads a video and decodes the frame at the start time while the warm surface is concealed, such
+		 *        that a later call to play with the same file and start time shows the first frame immediately.
+		 *
+		 * @param[in] videoFile The name of the video file.
+		 * @param[in] startTime The time at which the video will be played from.
+		 */
+		void preroll(const QString& videoFile, size_t startTime);
+	protected slots:
+		/**
+		 * @brief Applies a pending seek once the media is loaded and reveals a pending warm surface once a frame
+		 *        of the video is available.
+		 *
+		 * @param[in] status The media status of the player.
+		 */
+		void mediaStatusChanged(QMediaPlayer::MediaStatus status);
 	protected:
+		/**
+		 * @brief Loads a video file and seeks to the start time. The loaded file is only sought if it is the same file.
+		 *
+		 * @param[in] videoFile The name of the video file.
+		 * @param[in] startTime The time at which the video file will be played from.
+		 */
+		void load(const QString& videoFile, size_t startTime);
+
+		/**
+		 * @brief Unloads the media of the player and closes its device.
+		 */
+		void unload();
+
+		/**
+		 * @brief Sets the media of the player, read from the quiz pack if it contains the file.
+		 *
+		 * @param[in] mediaFile The media file.
+		 */
+		void setMedia(const QString& mediaFile);
+
 		/**
 		 * @brief Override the mouse release event.
 		 *
@@ -112,6 +210,17 @@ namespace media {
 		QVideoWidget* _videoWidget = nullptr;
 		VideoPlayState _state = VideoPlayState::IDLE;
 
+		MusicQuiz::util::QuizPack::CPtr _quizPack = nullptr;
+		QIODevice* _mediaDevice = nullptr;
+		QString _mediaFile = "";
+		qint64 _pendingSeek = -1;
+
+		/** Warm surface */
+		bool _warmSurface = false;
+		bool _concealed = false;
+		bool _revealPending = false;
+		bool _frameReady = false;
+
 		std::function< void(QMouseEvent*) > _mouseEventCallback;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include <chrono>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <functional>
+
+#include <boost/filesystem.hpp>
+
+#include "util/QuizCatalog.hpp"
+
+
+namespace {
+	/** Synthetic library, 100 quizzes with 5 categories of 100 media files each, i.e. 50k media files */
+	constexpr size_t NUMBER_OF_QUIZZES = 100;
+	constexpr size_t NUMBER_OF_CATEGORIES = 5;
+	constexpr size_t NUMBER_OF_MEDIA_FILES = 100;
+
+	void createLibrary(const std::string& dataFolder)
+	{
+		for ( size_t i = 0; i < NUMBER_OF_QUIZZES; ++i ) {
+			const std::string quizName = "Quiz" + std::to_string(i);
+			const std::string quizPath = dataFolder + "/" + quizName;
+			boost::filesystem::create_directories(quizPath);
+
+			std::ofstream quizFile(quizPath + "/" + quizName + ".quiz.xml");
+			quizFile << "<MusicQuiz><QuizName>" << quizName << "</QuizName><QuizAuthor>Benchmark</QuizAuthor>"
+				<< "<QuizDescription>Synthetic quiz.</QuizDescription></MusicQuiz>";
+
+			for ( size_t j = 0; j < NUMBER_OF_CATEGORIES; ++j ) {
+				const std::string mediaPath = quizPath + "/media/Category" + std::to_string(j);
+				boost::filesystem::create_directories(mediaPath);
+				for ( size_t k = 0; k < NUMBER_OF_MEDIA_FILES; ++k ) {
+					std::ofstream(mediaPath + "/Song" + std::to_string(k) + ".mp3");
+				}
+			}
+		}
+	}
+
+	size_t recursiveDiscovery(const std::string& dataFolder)
+	{
+		/** The discovery used before the catalog, every file below the data folder is visited */
+		size_t quizzes = 0;
+		boost::filesystem::recursive_directory_iterator end;
+		for ( boost::filesystem::recursive_directory_iterator file(dataFolder); file != end; ++file ) {
+			if ( file->path().string().find(".quiz.xml") != std::string::npos ) {
+				++quizzes;
+			}
+		}
+		return quizzes;
+	}
+
+	void benchmark(const std::string& name, const std::function<size_t()>& function)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		const size_t quizzes = function();
+		const auto end = std::chrono::steady_clock::now();
+		std::cout << name << ": " << quizzes << " quizzes in "
+			<< std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0 << " ms" << std::endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	/** Library Folder */
+	const boost::filesystem::path root = argc > 1 ? boost::filesystem::path(argv[1]) :
+		boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("musicquiz-benchmark-%%%%%%%%");
+	const std::string dataFolder = (root / "data").string();
+	const std::string catalogFile = (root / "data.catalog.xml").string();
+
+	std::cout << "Creating synthetic library in '" << dataFolder << "' with " << NUMBER_OF_QUIZZES << " quizzes and "
+		<< NUMBER_OF_QUIZZES * NUMBER_OF_CATEGORIES * NUMBER_OF_MEDIA_FILES << " media files." << std::endl;
+	createLibrary(dataFolder);
+
+	/** Benchmarks */
+	benchmark("Recursive discovery", [&]() {
+		return recursiveDiscovery(dataFolder);
+	});
+
+	benchmark("Catalog discovery (cold)", [&]() {
+		boost::filesystem::remove(catalogFile);
+		MusicQuiz::util::QuizCatalog catalog(dataFolder, catalogFile);
+		catalog.refresh();
+		return catalog.size();
+	});
+
+	benchmark("Catalog discovery (warm)", [&]() {
+		MusicQuiz::util::QuizCatalog catalog(dataFolder, catalogFile);
+		catalog.refresh();
+		return catalog.size();
+	});
+
+	/** Cleanup */
+	if ( argc <= 1 ) {
+		boost::filesystem::remove_all(root);
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,203 @@
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <functional>
+
+#include <boost/filesystem.hpp>
+
+#include "common/StringArena.hpp"
+#include "util/QuizLoader.hpp"
+#include "util/QuizCatalog.hpp"
+#include "util/QuizDocument.hpp"
+
+
+namespace {
+	/** Synthetic quiz, 20 categories of 100 entries each, i.e. 2000 entries with 3000 empty media files */
+	constexpr size_t NUMBER_OF_CATEGORIES = 20;
+	constexpr size_t NUMBER_OF_ENTRIES = 100;
+
+	std::atomic<size_t> allocations(0);
+	std::atomic<size_t> allocatedBytes(0);
+
+	std::string createQuiz(const std::string& dataFolder)
+	{
+		const std::string quizPath = dataFolder + "/Allocations";
+		boost::filesystem::create_directories(quizPath);
+
+		const std::string quizFile = quizPath + "/Allocations.quiz.xml";
+		std::ofstream quiz(quizFile);
+		quiz << "<MusicQuiz><QuizName>Allocations</QuizName><QuizAuthor>Benchmark</QuizAuthor>"
+			<< "<QuizDescription>Synthetic quiz.</QuizDescription><QuizCategories>";
+		for ( size_t i = 0; i < NUMBER_OF_CATEGORIES; ++i ) {
+			const std::string categoryName = "Category" + std::to_string(i);
+			boost::filesystem::create_directories(quizPath + "/media/" + categoryName);
+			quiz << "<Category name=\"" << categoryName << "\">";
+			for ( size_t j = 0; j < NUMBER_OF_ENTRIES; ++j ) {
+				const std::string entryName = "Entry" + std::to_string(j);
+				const std::string mediaPath = "./data/Allocations/media/" + categoryName + "/" + entryName;
+				if ( j % 2 == 0 ) {
+					quiz << "<QuizEntry name=\"" << entryName << "\" type=\"song\"><Answer>The answer of song " << j << "</Answer>"
+						<< "<Points>" << (j + 1) * 100 << "</Points><StartTime>1000</StartTime><AnswerStartTime>2000</AnswerStartTime>"
+						<< "<Media><SongFile>" << mediaPath << ".mp3</SongFile></Media></QuizEntry>";
+					std::ofstream(mediaPath + ".mp3");
+				} else {
+					quiz << "<QuizEntry name=\"" << entryName << "\" type=\"video\"><Answer>The answer of video " << j << "</Answer>"
+						<< "<Points>" << (j + 1) * 100 << "</Points><StartTime>1000</StartTime><VideoSongStartTime>1500</VideoSongStartTime>"
+						<< "<AnswerStartTime>2000</AnswerStartTime><Media><SongFile>" << mediaPath << "_song.mp3</SongFile>"
+						<< "<VideoFile>" << mediaPath << "_video.mp4</VideoFile></Media></QuizEntry>";
+					std::ofstream(mediaPath + "_song.mp3");
+					std::ofstream(mediaPath + "_video.mp4");
+				}
+			}
+			quiz << "</Category>";
+		}
+		quiz << "</QuizCategories></MusicQuiz>";
+
+		return quizFile;
+	}
+
+	struct Entry
+	{
+		std::string answer = "";
+		std::string songFile = "";
+		std::string videoFile = "";
+	};
+
+	size_t buildEntryStrings(const MusicQuiz::util::QuizDocument& document)
+	{
+		/** The loader used before the string arena, every string is copied and every path concatenated */
+		std::vector<Entry> entries;
+		for ( const MusicQuiz::util::QuizDocument::Category& category : document.categories ) {
+			for ( const MusicQuiz::util::QuizDocument::Entry& documentEntry : category.entries ) {
+				const std::string fullPath = MusicQuiz::util::QuizCatalog::normalizePath(boost::filesystem::current_path().string());
+				Entry entry;
+				entry.answer = documentEntry.answer;
+				entry.songFile = MusicQuiz::util::QuizCatalog::normalizePath(fullPath + "/" + documentEntry.songFile);
+				if ( documentEntry.type == "video" ) {
+					entry.videoFile = MusicQuiz::util::QuizCatalog::normalizePath(fullPath + "/" + documentEntry.videoFile);
+				}
+				entries.push_back(entry);
+			}
+		}
+		return entries.size();
+	}
+
+	size_t buildInternedEntryStrings(const MusicQuiz::util::QuizDocument& document)
+	{
+		size_t entries = 0;
+		common::StringArena strings;
+		const std::string fullPath = boost::filesystem::current_path().string();
+		for ( const MusicQuiz::util::QuizDocument::Category& category : document.categories ) {
+			for ( const MusicQuiz::util::QuizDocument::Entry& documentEntry : category.entries ) {
+				strings.intern(documentEntry.answer);
+				strings.internPath(fullPath, documentEntry.songFile);
+				if ( documentEntry.type == "video" ) {
+					strings.internPath(fullPath, documentEntry.videoFile);
+				}
+				++entries;
+			}
+		}
+		return entries;
+	}
+
+	void benchmark(const std::string& name, const std::function<size_t()>& function)
+	{
+		const size_t startAllocations = allocations;
+		const size_t startBytes = allocatedBytes;
+		const auto start = std::chrono::steady_clock::now();
+		const size_t entries = function();
+		const auto end = std::chrono::steady_clock::now();
+		std::cout << name << ": " << entries << " entries, " << allocations - startAllocations << " allocations ("
+			<< (allocatedBytes - startBytes) / 1024 << " KiB) in "
+			<< std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0 << " ms" << std::endl;
+	}
+
+	size_t countEntries(const MusicQuiz::util::QuizModel& model)
+	{
+		size_t entries = 0;
+		for ( const MusicQuiz::util::QuizModel::Category& category : model.categories ) {
+			entries += category.entries.size();
+		}
+		return entries;
+	}
+}
+
+void* operator new(std::size_t size)
+{
+	++allocations;
+	allocatedBytes += size;
+	void* ptr = std::malloc(size == 0 ? 1 : size);
+	if ( ptr == nullptr ) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+int main(int argc, char* argv[])
+{
+	/** Quiz Folder, the loader reads the quizzes from './data' */
+	const boost::filesystem::path root = argc > 1 ? boost::filesystem::path(argv[1]) :
+		boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("musicquiz-allocations-%%%%%%%%");
+	boost::filesystem::create_directories(root / "data");
+	boost::filesystem::current_path(root);
+
+	std::cout << "Creating synthetic quiz in '" << root.string() << "' with " << NUMBER_OF_CATEGORIES * NUMBER_OF_ENTRIES << " entries." << std::endl;
+	const std::string quizFile = createQuiz("./data");
+	const MusicQuiz::util::QuizDocument::CPtr document = MusicQuiz::util::QuizDocument::load(quizFile);
+
+	/** Benchmarks */
+	benchmark("Entry strings (std::string)", [&]() {
+		return buildEntryStrings(*document);
+	});
+
+	benchmark("Entry strings (string arena)", [&]() {
+		return buildInternedEntryStrings(*document);
+	});
+
+	const std::string quizId = MusicQuiz::util::QuizLoader::getQuizId(MusicQuiz::util::QuizLoader::getListOfQuizzes().front());
+	benchmark("Load quiz model (cold)", [&]() {
+		return countEntries(*MusicQuiz::util::QuizLoader::loadQuizModel(quizId));
+	});
+
+	benchmark("Load quiz model (warm)", [&]() {
+		return countEntries(*MusicQuiz::util::QuizLoader::loadQuizModel(quizId));
+	});
+
+	/** Cleanup */
+	if ( argc <= 1 ) {
+		boost::filesystem::current_path(root.parent_path());
+		boost::filesystem::remove_all(root);
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+#include <QString>
+#include <QEventLoop>
+#include <QApplication>
+#include <QMediaPlayer>
+#include <QElapsedTimer>
+
+#include <boost/filesystem.hpp>
+
+#include "media/AudioPlayer.hpp"
+
+
+namespace {
+	/** Number of plays measured per scenario */
+	constexpr size_t NUMBER_OF_PLAYS = 20;
+
+	/** Time to wait for the playback to start before the play counts as failed in milliseconds */
+	constexpr qint64 PLAY_TIMEOUT = 5000;
+
+	/** Length of the generated audio files in seconds */
+	constexpr uint32_t AUDIO_LENGTH = 30;
+
+	/** Start times used by the plays, i.e. the question and answer start times of an entry */
+	constexpr size_t QUESTION_START_TIME = 5000;
+	constexpr size_t ANSWER_START_TIME = 15000;
+
+	/**
+	 * @brief Audio player that exposes the active media player.
+	 */
+	class MeasuredAudioPlayer : public media::AudioPlayer
+	{
+	public:
+		QMediaPlayer* getPlayer() const
+		{
+			return _player;
+		}
+	};
+
+	template <typename T>
+	void writeValue(std::ofstream& stream, const T value)
+	{
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	void writeWaveFile(const std::string& fileName, const double frequency)
+	{
+		constexpr uint32_t sampleRate = 44100;
+		constexpr uint16_t channels = 2;
+		constexpr uint16_t bitsPerSample = 16;
+		constexpr uint32_t dataSize = AUDIO_LENGTH * sampleRate * channels * (bitsPerSample / 8);
+
+		std::ofstream stream(fileName, std::ios::binary);
+		stream.write("RIFF", 4);
+		writeValue<uint32_t>(stream, 36 + dataSize);
+		stream.write("WAVEfmt ", 8);
+		writeValue<uint32_t>(stream, 16);
+		writeValue<uint16_t>(stream, 1);
+		writeValue<uint16_t>(stream, channels);
+		writeValue<uint32_t>(stream, sampleRate);
+		writeValue<uint32_t>(stream, sampleRate * channels * (bitsPerSample / 8));
+		writeValue<uint16_t>(stream, channels * (bitsPerSample / 8));
+		writeValue<uint16_t>(stream, bitsPerSample);
+		stream.write("data", 4);
+		writeValue<uint32_t>(stream, dataSize);
+
+		/** Square wave, the content does not matter but silence might be skipped by some backends */
+		const uint32_t period = static_cast<uint32_t>(sampleRate / frequency);
+		for ( uint32_t i = 0; i < AUDIO_LENGTH * sampleRate; ++i ) {
+			const int16_t sample = (i % period) < period / 2 ? 1000 : -1000;
+			for ( uint16_t channel = 0; channel < channels; ++channel ) {
+				writeValue<int16_t>(stream, sample);
+			}
+		}
+	}
+
+	/**
+	 * @brief Plays an audio file and measures the time until the position advances past the start time.
+	 *
+	 * @return The latency in milliseconds or -1 if the playback did not start.
+	 */
+	qint64 measurePlay(MeasuredAudioPlayer& audioPlayer, const QString& audioFile, const size_t startTime)
+	{
+		QElapsedTimer timer;
+		timer.start();
+		audioPlayer.play(audioFile, startTime);
+
+		while ( timer.elapsed() < PLAY_TIMEOUT ) {
+			QApplication::processEvents(QEventLoop::AllEvents, 1);
+			QMediaPlayer* player = audioPlayer.getPlayer();
+			player->setNotifyInterval(1);
+			if ( player->state() == QMediaPlayer::PlayingState && player->position() > static_cast<qint64>(startTime) ) {
+				return timer.elapsed();
+			}
+		}
+		return -1;
+	}
+
+	void printLatencies(const std::string& name, std::vector<qint64> latencies)
+	{
+		std::sort(latencies.begin(), latencies.end());
+		std::cout << name << ": median " << latencies[latencies.size() / 2] << " ms, min " << latencies.front()
+			<< " ms, max " << latencies.back() << " ms" << std::endl;
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	/** Create QApplication */
+	QApplication app(argc, argv);
+
+	/** Audio Files */
+	const boost::filesystem::path folder = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("seek_latency_%%%%%%%%");
+	boost::filesystem::create_directories(folder);
+	const std::string firstFile = (folder / "first.wav").string();
+	const std::string secondFile = (folder / "second.wav").string();
+	writeWaveFile(firstFile, 440.0);
+	writeWaveFile(secondFile, 660.0);
+
+	/** Player */
+	MeasuredAudioPlayer audioPlayer;
+
+	/** Reopen, alternating files such that every play has to open its file */
+	std::vector<qint64> reopenLatencies;
+	std::vector<qint64> seekLatencies;
+	for ( size_t i = 0; i < NUMBER_OF_PLAYS; ++i ) {
+		const QString audioFile = QString::fromStdString(i % 2 == 0 ? firstFile : secondFile);
+		reopenLatencies.push_back(measurePlay(audioPlayer, audioFile, QUESTION_START_TIME));
+	}
+
+	/** Same file, question to answer and replaying the answer */
+	for ( size_t i = 0; i < NUMBER_OF_PLAYS; ++i ) {
+		const size_t startTime = i % 2 == 0 ? ANSWER_START_TIME : QUESTION_START_TIME;
+		seekLatencies.push_back(measurePlay(audioPlayer, QString::fromStdString(firstFile), startTime));
+	}
+	audioPlayer.stop();
+
+	boost::system::error_code error;
+	boost::filesystem::remove_all(folder, error);
+
+	if ( std::find(reopenLatencies.begin(), reopenLatencies.end(), -1) != reopenLatencies.end() ||
+		std::find(seekLatencies.begin(), seekLatencies.end(), -1) != seekLatencies.end() ) {
+		std::cout << "Playback did not start within " << PLAY_TIMEOUT << " ms, no usable media backend." << std::endl;
+		return 1;
+	}
+
+	printLatencies("Reopen", reopenLatencies);
+	printLatencies("Same file seek", seekLatencies);
+
+	/** The same file has to start at least as fast as reopening it */
+	std::sort(reopenLatencies.begin(), reopenLatencies.end());
+	std::sort(seekLatencies.begin(), seekLatencies.end());
+	return seekLatencies[seekLatencies.size() / 2] <= reopenLatencies[reopenLatencies.size() / 2] ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include "common/Log.hpp"
+#include "util/MediaStore.hpp"
+#include "util/QuizLoader.hpp"
+
+
+/**
+ * Moves the media folders of the quizzes in './data' to the shared media store and removes the stored media that is
+ * no longer referenced. Run from the folder containing './data'. With '--gc' only the unreferenced media is removed.
+ * The unreferenced media is kept if a quiz failed to migrate, as the failed quiz may still need to be migrated again.
+ */
+int main(int argc, char* argv[])
+{
+	const bool collectGarbageOnly = argc > 1 && std::string(argv[1]) == "--gc";
+
+	try {
+		const std::vector<std::string> quizFiles = MusicQuiz::util::QuizLoader::getListOfQuizzes();
+
+		/** Migrate Quizzes */
+		if ( !collectGarbageOnly ) {
+			MusicQuiz::util::MediaStore::MigrationStatistics total;
+			size_t failed = 0;
+			for ( const std::string& quizFile : quizFiles ) {
+				try {
+					const MusicQuiz::util::MediaStore::MigrationStatistics statistics = MusicQuiz::util::MediaStore::migrate(quizFile);
+					total.files += statistics.files;
+					total.duplicates += statistics.duplicates;
+					total.duplicateBytes += statistics.duplicateBytes;
+				} catch ( const std::exception& err ) {
+					LOG_ERROR("Failed to migrate quiz '" << quizFile << "'. " << err.what());
+					++failed;
+				}
+			}
+
+			std::cout << "Migrated " << total.files << " media files of " << quizFiles.size() << " quizzes to '"
+				<< MusicQuiz::util::MediaStore::getStoreDirectory() << "', " << total.duplicates << " duplicates ("
+				<< total.duplicateBytes / (1024 * 1024) << " MB) are stored once." << std::endl;
+
+			if ( failed > 0 ) {
+				std::cout << "Failed to migrate " << failed << " quizzes, the unreferenced media files are kept." << std::endl;
+				return 1;
+			}
+		}
+
+		/** Remove Unreferenced Media */
+		const size_t removed = MusicQuiz::util::MediaStore::collectGarbage(quizFiles);
+		std::cout << "Removed " << removed << " unreferenced media files." << std::endl;
+	} catch ( const std::exception& err ) {
+		LOG_ERROR("Failed to migrate the media. " << err.what());
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
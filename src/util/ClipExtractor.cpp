@@ -0,0 +1,100 @@
+#include "ClipExtractor.hpp"
+
+#include <cstdlib>
+#include <algorithm>
+#include <stdexcept>
+
+#include <QString>
+#include <QProcess>
+#include <QStringList>
+
+#include "common/Log.hpp"
+
+
+namespace {
+	/** Maximum time to extract a clip in milliseconds */
+	constexpr int EXTRACT_TIMEOUT = 10 * 60 * 1000;
+
+	/** Maximum time to check the ffmpeg version in milliseconds */
+	constexpr int VERSION_TIMEOUT = 5000;
+
+	QString toSeconds(const size_t milliseconds)
+	{
+		return QString::number(static_cast<double>(milliseconds) / 1000.0, 'f', 3);
+	}
+}
+
+
+bool MusicQuiz::util::ClipExtractor::isAvailable()
+{
+	QProcess process;
+	process.start(QString::fromStdString(getExecutable()), QStringList() << "-version");
+	if ( !process.waitForFinished(VERSION_TIMEOUT) ) {
+		process.kill();
+		return false;
+	}
+
+	return process.exitStatus() == QProcess::NormalExit && process.exitCode() == 0;
+}
+
+size_t MusicQuiz::util::ClipExtractor::getClipStart(const std::initializer_list<size_t> startTimes, const size_t preRoll)
+{
+	const size_t first = std::min(startTimes);
+	return first > preRoll ? first - preRoll : 0;
+}
+
+size_t MusicQuiz::util::ClipExtractor::getClipEnd(const std::initializer_list<size_t> startTimes, const size_t postRoll)
+{
+	return std::max(startTimes) + postRoll;
+}
+
+void MusicQuiz::util::ClipExtractor::extractAudio(const std::string& source, const std::string& target, const size_t start, const size_t end)
+{
+	run(source, target, start, end, { "-vn", "-c:a", "copy" });
+}
+
+void MusicQuiz::util::ClipExtractor::extractVideo(const std::string& source, const std::string& target, const size_t start, const size_t end)
+{
+	run(source, target, start, end, { "-c:v", "libx264", "-preset", "veryfast", "-crf", "20", "-pix_fmt", "yuv420p", "-c:a", "aac", "-movflags", "+faststart" });
+}
+
+std::string MusicQuiz::util::ClipExtractor::getExecutable()
+{
+	const char* executable = std::getenv("MUSICQUIZ_FFMPEG");
+	return executable != nullptr && executable[0] != '\0' ? executable : "ffmpeg";
+}
+
+void MusicQuiz::util::ClipExtractor::run(const std::string& source, const std::string& target, const size_t start, const size_t end, const std::initializer_list<const char*> codecArguments)
+{
+	if ( end <= start ) {
+		throw std::runtime_error("The clip of '" + source + "' is empty.");
+	}
+
+	/** Arguments, seeking before the input is fast and the timestamps of the clip start at zero */
+	QStringList arguments;
+	arguments << "-hide_banner" << "-loglevel" << "error" << "-nostdin" << "-y"
+		<< "-ss" << toSeconds(start) << "-i" << QString::fromStdString(source) << "-t" << toSeconds(end - start);
+	for ( const char* argument : codecArguments ) {
+		arguments << argument;
+	}
+	arguments << QString::fromStdString(target);
+
+	/** Extract */
+	QProcess process;
+	process.start(QString::fromStdString(getExecutable()), arguments);
+	if ( !process.waitForStarted() ) {
+		throw std::runtime_error("Failed to run ffmpeg. " + process.errorString().toStdString());
+	}
+
+	if ( !process.waitForFinished(EXTRACT_TIMEOUT) ) {
+		process.kill();
+		process.waitForFinished();
+		throw std::runtime_error("Timed out extracting the clip of '" + source + "'.");
+	}
+
+	if ( process.exitStatus() != QProcess::NormalExit || process.exitCode() != 0 ) {
+		throw std::runtime_error("Failed to extract the clip of '" + source + "'. " + QString::fromLocal8Bit(process.readAllStandardError()).trimmed().toStdString());
+	}
+
+	LOG_DEBUG("Extracted " << toSeconds(start).toStdString() << " s to " << toSeconds(end).toStdString() << " s of '" << source << "' to '" << target << "'.");
+}
\ No newline at end of file
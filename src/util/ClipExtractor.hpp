@@ -0,0 +1,104 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+#include <initializer_list>
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Extracts the parts of the media files that are played in a quiz into clip files using ffmpeg.
+		 *
+		 * A clip covers the start times of an entry with a pre roll before the first and a post roll after the last
+		 * start time. The start times of the entry are relative to the start of the clip.
+		 */
+		class ClipExtractor
+		{
+		public:
+			/**
+			 * @brief Deleted constructor.
+			 */
+			ClipExtractor() = delete;
+
+			/**
+			 * @brief Deleted Destructor.
+			 */
+			~ClipExtractor() = delete;
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			ClipExtractor(const ClipExtractor&) = delete;
+			ClipExtractor& operator=(const ClipExtractor&) = delete;
+
+			/**
+			 * @brief Returns true if ffmpeg can be run. The ffmpeg executable is taken from the MUSICQUIZ_FFMPEG
+			 *        environment variable or found on the path.
+			 *
+			 * @return True if ffmpeg is available.
+			 */
+			static bool isAvailable();
+
+			/**
+			 * @brief Returns the start of the clip covering a set of start times.
+			 *
+			 * @param[in] startTimes The start times in milliseconds.
+			 * @param[in] preRoll The time before the first start time in milliseconds.
+			 *
+			 * @return The start of the clip in milliseconds.
+			 */
+			static size_t getClipStart(std::initializer_list<size_t> startTimes, size_t preRoll);
+
+			/**
+			 * @brief Returns the end of the clip covering a set of start times.
+			 *
+			 * @param[in] startTimes The start times in milliseconds.
+			 * @param[in] postRoll The time after the last start time in milliseconds.
+			 *
+			 * @return The end of the clip in milliseconds.
+			 */
+			static size_t getClipEnd(std::initializer_list<size_t> startTimes, size_t postRoll);
+
+			/**
+			 * @brief Extracts an audio clip. The audio is copied without encoding.
+			 *
+			 * @param[in] source The source file.
+			 * @param[in] target The clip file.
+			 * @param[in] start The start of the clip in milliseconds.
+			 * @param[in] end The end of the clip in milliseconds.
+			 */
+			static void extractAudio(const std::string& source, const std::string& target, size_t start, size_t end);
+
+			/**
+			 * @brief Extracts a video clip. The video is encoded such that the clip starts exactly at the start time
+			 *        and not at the preceding key frame.
+			 *
+			 * @param[in] source The source file.
+			 * @param[in] target The clip file.
+			 * @param[in] start The start of the clip in milliseconds.
+			 * @param[in] end The end of the clip in milliseconds.
+			 */
+			static void extractVideo(const std::string& source, const std::string& target, size_t start, size_t end);
+
+		protected:
+			/**
+			 * @brief Returns the ffmpeg executable.
+			 *
+			 * @return The executable.
+			 */
+			static std::string getExecutable();
+
+			/**
+			 * @brief Runs ffmpeg.
+			 *
+			 * @param[in] source The source file.
+			 * @param[in] target The clip file.
+			 * @param[in] start The start of the clip in milliseconds.
+			 * @param[in] end The end of the clip in milliseconds.
+			 * @param[in] codecArguments The codec arguments.
+			 */
+			static void run(const std::string& source, const std::string& target, size_t start, size_t end, std::initializer_list<const char*> codecArguments);
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+#include "FunctionTask.hpp"
+
+
+MusicQuiz::util::FunctionTask::FunctionTask(const std::function<void()>& function) :
+	_function(function)
+{
+}
+
+void MusicQuiz::util::FunctionTask::run()
+{
+	_function();
+}
\ No newline at end of file
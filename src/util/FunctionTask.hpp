@@ -0,0 +1,44 @@
+#pragma once
+
+#include <functional>
+
+#include <QRunnable>
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Runnable that calls a function, used to run work on a QThreadPool.
+		 */
+		class FunctionTask : public QRunnable
+		{
+		public:
+			/**
+			 * @brief Constructor
+			 *
+			 * @param[in] function The function to run.
+			 */
+			explicit FunctionTask(const std::function<void()>& function);
+
+			/**
+			 * @brief Default Destructor
+			 */
+			virtual ~FunctionTask() = default;
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			FunctionTask(const FunctionTask&) = delete;
+			FunctionTask& operator=(const FunctionTask&) = delete;
+
+			/**
+			 * @brief Runs the function.
+			 */
+			void run() override;
+
+		private:
+			/** Variables */
+			std::function<void()> _function;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,258 @@
+#include "MediaPrefetcher.hpp"
+
+#include <map>
+#include <chrono>
+#include <fstream>
+#include <algorithm>
+#include <string_view>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <boost/filesystem.hpp>
+
+#include "common/Log.hpp"
+#include "util/QuizPack.hpp"
+#include "util/FunctionTask.hpp"
+
+
+namespace {
+	/** Bytes read at a time, the bandwidth is enforced between the chunks */
+	constexpr size_t CHUNK_SIZE = 256 * 1024;
+
+	/** Bytes read from the start and the end of each file, containers keep their metadata there */
+	constexpr uint64_t HEAD_SIZE = 256 * 1024;
+	constexpr uint64_t TAIL_SIZE = 256 * 1024;
+
+	/** The duration of a song is not known, the offset of a start time is estimated from the bounds of common
+	    audio bit rates, 128 kbit/s to 320 kbit/s, in bytes per millisecond */
+	constexpr uint64_t MIN_BYTE_RATE = 16;
+	constexpr uint64_t MAX_BYTE_RATE = 40;
+
+	/** Length of the part read after a start time in milliseconds */
+	constexpr uint64_t START_WINDOW = 20000;
+
+	/** Minimum time between the progress signals in milliseconds */
+	constexpr int64_t PROGRESS_INTERVAL = 250;
+
+	struct MediaFile
+	{
+		std::string file = "";
+		uint64_t size = 0;
+		std::vector<size_t> startTimes;
+	};
+}
+
+
+MusicQuiz::util::MediaPrefetcher::MediaPrefetcher(const size_t bandwidth, QObject* parent) :
+	QObject(parent), _bandwidth(bandwidth), _generation(0)
+{
+	_pool.setMaxThreadCount(1);
+}
+
+MusicQuiz::util::MediaPrefetcher::~MediaPrefetcher()
+{
+	/** Cancel and wait for the worker, its queued signals are discarded together with the prefetcher */
+	cancel();
+	_pool.waitForDone();
+}
+
+void MusicQuiz::util::MediaPrefetcher::start(const MusicQuiz::util::QuizModel::CPtr& model)
+{
+	/** Cancel the previous quiz */
+	cancel();
+	if ( model == nullptr || _bandwidth == 0 ) {
+		return;
+	}
+
+	const size_t generation = _generation;
+	const std::vector<Range> ranges = plan(*model);
+	_pool.start(new MusicQuiz::util::FunctionTask([this, ranges, generation]() {
+		try {
+			prefetch(ranges, generation);
+		} catch ( const std::exception& err ) {
+			LOG_WARN("Failed to prefetch media. " << err.what());
+		} catch ( ... ) {
+			LOG_WARN("Failed to prefetch media.");
+		}
+	}));
+}
+
+void MusicQuiz::util::MediaPrefetcher::cancel()
+{
+	{
+		std::lock_guard<std::mutex> lock(_cancelMutex);
+		++_generation;
+	}
+	_cancelled.notify_all();
+}
+
+bool MusicQuiz::util::MediaPrefetcher::isCancelled(const size_t generation) const
+{
+	return _generation != generation;
+}
+
+std::vector<MusicQuiz::util::MediaPrefetcher::Range> MusicQuiz::util::MediaPrefetcher::plan(const MusicQuiz::util::QuizModel& model)
+{
+	/** Media Files, in the order of the quiz with the start times of the songs */
+	std::vector<MediaFile> files;
+	std::map<std::string, size_t> fileIndices;
+	const auto addFile = [&](const std::string_view& file, const std::vector<size_t>& startTimes) {
+		if ( file.empty() || (model.quizPack != nullptr && model.quizPack->contains(std::string(file))) ) {
+			return;
+		}
+
+		auto it = fileIndices.find(std::string(file));
+		if ( it == fileIndices.end() ) {
+			MediaFile mediaFile;
+			mediaFile.file = std::string(file);
+			it = fileIndices.emplace(mediaFile.file, files.size()).first;
+			files.push_back(mediaFile);
+		}
+		std::vector<size_t>& fileStartTimes = files[it->second].startTimes;
+		fileStartTimes.insert(fileStartTimes.end(), startTimes.begin(), startTimes.end());
+	};
+
+	/** Packed media is read from the pack, which is read as a whole */
+	if ( model.quizPack != nullptr ) {
+		addFile(MusicQuiz::util::QuizPack::getPackFile(model.quizFile), {});
+	}
+
+	for ( const MusicQuiz::util::QuizModel::Category& category : model.categories ) {
+		for ( const MusicQuiz::util::QuizModel::Entry& entry : category.entries ) {
+			addFile(entry.songFile, { entry.songStartTime, entry.answerStartTime });
+			if ( entry.type == MusicQuiz::util::QuizModel::EntryType::VIDEO ) {
+				addFile(entry.videoFile, {});
+			}
+		}
+	}
+
+	/** Sizes, missing files are skipped */
+	files.erase(std::remove_if(files.begin(), files.end(), [](MediaFile& mediaFile) {
+		boost::system::error_code error;
+		mediaFile.size = boost::filesystem::file_size(mediaFile.file, error);
+		return error || mediaFile.size == 0;
+	}), files.end());
+
+	/** The parts that are played first, overlapping parts of a file are merged */
+	std::vector<Range> ranges;
+	for ( const MediaFile& mediaFile : files ) {
+		std::vector< std::pair<uint64_t, uint64_t> > parts;
+		parts.emplace_back(0, HEAD_SIZE);
+		for ( const size_t startTime : mediaFile.startTimes ) {
+			parts.emplace_back(startTime * MIN_BYTE_RATE, (startTime + START_WINDOW) * MAX_BYTE_RATE);
+		}
+		parts.emplace_back(mediaFile.size > TAIL_SIZE ? mediaFile.size - TAIL_SIZE : 0, mediaFile.size);
+
+		std::sort(parts.begin(), parts.end());
+		std::vector< std::pair<uint64_t, uint64_t> > merged;
+		for ( const std::pair<uint64_t, uint64_t>& part : parts ) {
+			if ( !merged.empty() && part.first <= merged.back().second ) {
+				merged.back().second = std::max(merged.back().second, part.second);
+			} else {
+				merged.push_back(part);
+			}
+		}
+
+		for ( const std::pair<uint64_t, uint64_t>& part : merged ) {
+			const uint64_t end = std::min(part.second, mediaFile.size);
+			if ( part.first < end ) {
+				ranges.push_back({ mediaFile.file, part.first, end - part.first });
+			}
+		}
+	}
+
+	/** Everything, the parts read before are served from the cache */
+	for ( const MediaFile& mediaFile : files ) {
+		ranges.push_back({ mediaFile.file, 0, mediaFile.size });
+	}
+
+	return ranges;
+}
+
+void MusicQuiz::util::MediaPrefetcher::prefetch(const std::vector<Range>& ranges, const size_t generation)
+{
+	typedef std::chrono::steady_clock Clock;
+	const Clock::time_point startTime = Clock::now();
+	Clock::time_point lastProgress = startTime;
+
+	uint64_t totalBytes = 0;
+	for ( const Range& range : ranges ) {
+		totalBytes += range.size;
+	}
+
+	std::vector<char> buffer(CHUNK_SIZE);
+	uint64_t prefetchedBytes = 0;
+	for ( const Range& range : ranges ) {
+#if defined(__unix__) || defined(__APPLE__)
+		const int fd = ::open(range.file.c_str(), O_RDONLY);
+		if ( fd < 0 ) {
+			continue;
+		}
+#if defined(POSIX_FADV_SEQUENTIAL)
+		/** Larger read ahead of the kernel for the range */
+		posix_fadvise(fd, static_cast<off_t>(range.offset), static_cast<off_t>(range.size), POSIX_FADV_SEQUENTIAL);
+#endif
+#else
+		std::ifstream file(range.file, std::ios::binary);
+		if ( !file.is_open() ) {
+			continue;
+		}
+		file.seekg(static_cast<std::streamoff>(range.offset));
+#endif
+
+		for ( uint64_t offset = 0; offset < range.size; ) {
+			if ( isCancelled(generation) ) {
+				break;
+			}
+
+			const size_t size = static_cast<size_t>(std::min<uint64_t>(CHUNK_SIZE, range.size - offset));
+#if defined(__unix__) || defined(__APPLE__)
+			const ssize_t bytesRead = ::pread(fd, buffer.data(), size, static_cast<off_t>(range.offset + offset));
+			if ( bytesRead <= 0 ) {
+				break;
+			}
+			offset += static_cast<uint64_t>(bytesRead);
+			prefetchedBytes += static_cast<uint64_t>(bytesRead);
+#else
+			file.read(buffer.data(), static_cast<std::streamsize>(size));
+			if ( file.gcount() <= 0 ) {
+				break;
+			}
+			offset += static_cast<uint64_t>(file.gcount());
+			prefetchedBytes += static_cast<uint64_t>(file.gcount());
+#endif
+
+			/** Bandwidth, wait until the bytes read are within the budget */
+			const Clock::time_point budgetTime = startTime + std::chrono::microseconds(prefetchedBytes * 1000000 / _bandwidth);
+			{
+				std::unique_lock<std::mutex> lock(_cancelMutex);
+				_cancelled.wait_until(lock, budgetTime, [this, generation]() { return isCancelled(generation); });
+			}
+
+			/** Progress */
+			const Clock::time_point now = Clock::now();
+			if ( std::chrono::duration_cast<std::chrono::milliseconds>(now - lastProgress).count() >= PROGRESS_INTERVAL ) {
+				lastProgress = now;
+				QMetaObject::invokeMethod(this, [this, prefetchedBytes, totalBytes]() { emit progress(prefetchedBytes, totalBytes); }, Qt::QueuedConnection);
+			}
+		}
+
+#if defined(__unix__) || defined(__APPLE__)
+		::close(fd);
+#endif
+
+		if ( isCancelled(generation) ) {
+			return;
+		}
+	}
+
+	/** Done */
+	const double seconds = std::chrono::duration<double>(Clock::now() - startTime).count();
+	QMetaObject::invokeMethod(this, [this, prefetchedBytes, totalBytes, seconds]() {
+		emit progress(prefetchedBytes, totalBytes);
+		emit finished(prefetchedBytes, seconds);
+	}, Qt::QueuedConnection);
+}
\ No newline at end of file
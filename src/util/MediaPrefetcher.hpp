@@ -0,0 +1,121 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <condition_variable>
+
+#include <QObject>
+#include <QThreadPool>
+
+#include "util/QuizModel.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Reads the media of a quiz in the background such that it is in the page cache of the operating system
+		 *        when it is played, quizzes are often played from slow external drives.
+		 *
+		 * The parts that are played first are read first: the start and end of each file, where the containers keep
+		 * their metadata, and the parts around the start times of the songs. Afterwards the files are read completely.
+		 * The reads are limited to a bandwidth such that the media that is playing is not starved.
+		 */
+		class MediaPrefetcher : public QObject
+		{
+			Q_OBJECT
+		public:
+			/**
+			 * @brief Constructor
+			 *
+			 * @param[in] bandwidth The maximum number of bytes read per second.
+			 * @param[in] parent The parent.
+			 */
+			explicit MediaPrefetcher(size_t bandwidth, QObject* parent = nullptr);
+
+			/**
+			 * @brief Destructor, cancels the prefetching and waits for the worker.
+			 */
+			virtual ~MediaPrefetcher();
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			MediaPrefetcher(const MediaPrefetcher&) = delete;
+			MediaPrefetcher& operator=(const MediaPrefetcher&) = delete;
+
+			/**
+			 * @brief Starts prefetching the media of a quiz, the prefetching of a previous quiz is cancelled.
+			 *
+			 * @param[in] model The quiz model.
+			 */
+			void start(const MusicQuiz::util::QuizModel::CPtr& model);
+
+			/**
+			 * @brief Cancels the prefetching.
+			 */
+			void cancel();
+
+		signals:
+			/**
+			 * @brief Emitted periodically while prefetching.
+			 *
+			 * @param[in] prefetchedBytes The number of bytes read.
+			 * @param[in] totalBytes The number of bytes that will be read.
+			 */
+			void progress(quint64 prefetchedBytes, quint64 totalBytes);
+
+			/**
+			 * @brief Emitted when all media has been read, not emitted if the prefetching is cancelled.
+			 *
+			 * @param[in] prefetchedBytes The number of bytes read.
+			 * @param[in] seconds The duration of the prefetching.
+			 */
+			void finished(quint64 prefetchedBytes, double seconds);
+
+		protected:
+			struct Range
+			{
+				std::string file = "";
+				uint64_t offset = 0;
+				uint64_t size = 0;
+			};
+
+			/**
+			 * @brief Plans the byte ranges to read, in the order they are read.
+			 *
+			 * @param[in] model The quiz model.
+			 *
+			 * @return The ranges.
+			 */
+			static std::vector<Range> plan(const MusicQuiz::util::QuizModel& model);
+
+			/**
+			 * @brief Reads the ranges within the bandwidth, runs on the worker thread.
+			 *
+			 * @param[in] ranges The ranges.
+			 * @param[in] generation The generation of the prefetch, a newer generation cancels it.
+			 */
+			void prefetch(const std::vector<Range>& ranges, size_t generation);
+
+			/**
+			 * @brief Returns true if the prefetch of a generation has been cancelled.
+			 *
+			 * @param[in] generation The generation.
+			 *
+			 * @return True if cancelled.
+			 */
+			bool isCancelled(size_t generation) const;
+
+			/** Variables */
+			size_t _bandwidth = 0;
+			QThreadPool _pool;
+
+			std::atomic<size_t> _generation;
+			mutable std::mutex _cancelMutex;
+			std::condition_variable _cancelled;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,225 @@
+#include "MediaStagingCache.hpp"
+
+#include <mutex>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#endif
+
+#include <boost/filesystem.hpp>
+
+#include "common/Log.hpp"
+#include "common/HashUtil.hpp"
+#include "util/QuizPack.hpp"
+
+
+namespace {
+	/** Suffix of the copies that are not complete yet */
+	const std::string PARTIAL_SUFFIX = ".partial";
+
+	/** The cache directory is shared by all caches */
+	std::mutex stagingMutex;
+}
+
+
+MusicQuiz::util::MediaStagingCache::MediaStagingCache(const std::string& directory, const uintmax_t quota) :
+	_directory(directory), _quota(quota)
+{
+}
+
+size_t MusicQuiz::util::MediaStagingCache::stage(MusicQuiz::util::QuizModel& model)
+{
+	std::lock_guard<std::mutex> lock(stagingMutex);
+	scan();
+	_pinned.clear();
+
+	/** Stage each media file once, in the order of the quiz */
+	std::unordered_map<std::string_view, std::string_view> stagedFiles;
+	const auto stageEntryFile = [&](std::string_view& file) {
+		if ( file.empty() || (model.quizPack != nullptr && model.quizPack->contains(std::string(file))) ) {
+			return;
+		}
+
+		auto it = stagedFiles.find(file);
+		if ( it == stagedFiles.end() ) {
+			const std::string stagedFile = stageFile(std::string(file));
+			it = stagedFiles.emplace(file, stagedFile.empty() ? file : model.strings->intern(stagedFile)).first;
+		}
+		file = it->second;
+	};
+
+	for ( MusicQuiz::util::QuizModel::Category& category : model.categories ) {
+		for ( MusicQuiz::util::QuizModel::Entry& entry : category.entries ) {
+			stageEntryFile(entry.songFile);
+			stageEntryFile(entry.videoFile);
+		}
+	}
+
+	const size_t count = static_cast<size_t>(std::count_if(stagedFiles.begin(), stagedFiles.end(), [](const auto& stagedFile) {
+		return stagedFile.first != stagedFile.second;
+	}));
+	LOG_INFO("Staged " << count << " of " << stagedFiles.size() << " media files in '" << _directory << "' (" << _size / (1024 * 1024) << " of " << _quota / (1024 * 1024) << " MB used).");
+	return count;
+}
+
+std::string MusicQuiz::util::MediaStagingCache::stageFile(const std::string& file)
+{
+	/** Source */
+	boost::system::error_code error;
+	const uintmax_t fileSize = boost::filesystem::file_size(file, error);
+	if ( error ) {
+		return "";
+	}
+	const std::time_t lastWriteTime = boost::filesystem::last_write_time(file, error);
+	if ( error ) {
+		return "";
+	}
+
+	/** Name, a changed source gets a new name */
+	uint64_t hash = common::HashUtil::hashBytes(file.data(), file.size());
+	hash = common::HashUtil::hashBytes(&fileSize, sizeof(fileSize), hash);
+	hash = common::HashUtil::hashBytes(&lastWriteTime, sizeof(lastWriteTime), hash);
+	const std::string name = common::HashUtil::toHex(hash) + boost::filesystem::path(file).extension().string();
+	const std::string stagedFile = (boost::filesystem::path(_directory) / name).string();
+
+	/** Staged, the use time of the file is updated for the eviction */
+	const std::time_t now = std::time(nullptr);
+	auto it = _files.find(name);
+	if ( it != _files.end() && it->second.size == fileSize ) {
+		boost::filesystem::last_write_time(stagedFile, now, error);
+		it->second.lastUse = now;
+		_pinned.insert(name);
+		return stagedFile;
+	}
+
+	/** Stale copy */
+	if ( it != _files.end() ) {
+		_size -= it->second.size;
+		_files.erase(it);
+	}
+
+	/** Make room */
+	if ( !evict(fileSize) ) {
+		LOG_DEBUG("Media file '" << file << "' does not fit in the staging cache.");
+		return "";
+	}
+
+	/** Copy, the copy is renamed when complete such that an interrupted copy is never used */
+	const std::string partialFile = stagedFile + PARTIAL_SUFFIX;
+	try {
+		copy(file, partialFile);
+		boost::filesystem::rename(partialFile, stagedFile);
+	} catch ( const std::exception& err ) {
+		LOG_WARN("Failed to stage media file '" << file << "'. " << err.what());
+		boost::filesystem::remove(partialFile, error);
+		return "";
+	}
+
+	StagedFile& staged = _files[name];
+	staged.size = fileSize;
+	staged.lastUse = now;
+	_size += fileSize;
+	_pinned.insert(name);
+	return stagedFile;
+}
+
+uintmax_t MusicQuiz::util::MediaStagingCache::size() const
+{
+	return _size;
+}
+
+void MusicQuiz::util::MediaStagingCache::scan()
+{
+	_files.clear();
+	_size = 0;
+
+	boost::system::error_code error;
+	boost::filesystem::create_directories(_directory, error);
+	if ( error ) {
+		throw std::runtime_error("Failed to create the staging directory '" + _directory + "'. " + error.message());
+	}
+
+	for ( boost::filesystem::directory_iterator it(_directory), end; it != end; ++it ) {
+		const boost::filesystem::path& path = it->path();
+		if ( !boost::filesystem::is_regular_file(path, error) ) {
+			continue;
+		}
+
+		/** Incomplete copy of an interrupted staging */
+		if ( path.extension().string() == PARTIAL_SUFFIX ) {
+			boost::filesystem::remove(path, error);
+			continue;
+		}
+
+		StagedFile& staged = _files[path.filename().string()];
+		staged.size = boost::filesystem::file_size(path, error);
+		staged.lastUse = boost::filesystem::last_write_time(path, error);
+		_size += staged.size;
+	}
+}
+
+bool MusicQuiz::util::MediaStagingCache::evict(const uintmax_t required)
+{
+	if ( required > _quota ) {
+		return false;
+	}
+
+	if ( _size + required <= _quota ) {
+		return true;
+	}
+
+	/** Least recently used first */
+	std::vector< std::pair<std::time_t, std::string> > candidates;
+	for ( const auto& file : _files ) {
+		if ( _pinned.find(file.first) == _pinned.end() ) {
+			candidates.emplace_back(file.second.lastUse, file.first);
+		}
+	}
+	std::sort(candidates.begin(), candidates.end());
+
+	for ( const std::pair<std::time_t, std::string>& candidate : candidates ) {
+		if ( _size + required <= _quota ) {
+			break;
+		}
+
+		boost::system::error_code error;
+		boost::filesystem::remove(boost::filesystem::path(_directory) / candidate.second, error);
+		if ( error ) {
+			continue;
+		}
+
+		_size -= _files[candidate.second].size;
+		_files.erase(candidate.second);
+	}
+
+	return _size + required <= _quota;
+}
+
+void MusicQuiz::util::MediaStagingCache::copy(const std::string& source, const std::string& target)
+{
+#if defined(__linux__) && defined(FICLONE)
+	/** Reflink, the copy shares the blocks of the source until either is changed */
+	const int sourceFd = ::open(source.c_str(), O_RDONLY);
+	if ( sourceFd >= 0 ) {
+		const int targetFd = ::open(target.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		const bool cloned = targetFd >= 0 && ::ioctl(targetFd, FICLONE, sourceFd) == 0;
+		if ( targetFd >= 0 ) {
+			::close(targetFd);
+		}
+		::close(sourceFd);
+
+		if ( cloned ) {
+			return;
+		}
+	}
+#endif
+
+	boost::filesystem::copy_file(source, target, boost::filesystem::copy_option::overwrite_if_exists);
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <set>
+#include <map>
+#include <ctime>
+#include <string>
+#include <cstdint>
+
+#include "util/QuizModel.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Copies the media of a quiz to a local cache directory such that the playback does not depend on the
+		 *        latency of the drive the quiz is stored on, quizzes are often played from slow or removable drives.
+		 *
+		 * A staged file is named by the hash of its source path, size and modification time, such that a changed
+		 * source is staged again. The files are reflinked where the file system supports it and copied otherwise. The
+		 * least recently used files are evicted when the cache exceeds its quota.
+		 */
+		class MediaStagingCache
+		{
+		public:
+			/**
+			 * @brief Constructor
+			 *
+			 * @param[in] directory The cache directory.
+			 * @param[in] quota The maximum size of the cache in bytes.
+			 */
+			MediaStagingCache(const std::string& directory, uintmax_t quota);
+
+			/**
+			 * @brief Destructor
+			 */
+			~MediaStagingCache() = default;
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			MediaStagingCache(const MediaStagingCache&) = delete;
+			MediaStagingCache& operator=(const MediaStagingCache&) = delete;
+
+			/**
+			 * @brief Stages the media files of a quiz and replaces the media files of the entries by the staged copies.
+			 *        Media files in the quiz pack and files that cannot be staged are played from their source.
+			 *
+			 * @param[in,out] model The quiz model.
+			 *
+			 * @return The number of media files played from the cache.
+			 */
+			size_t stage(MusicQuiz::util::QuizModel& model);
+
+			/**
+			 * @brief Stages a media file.
+			 *
+			 * @param[in] file The media file.
+			 *
+			 * @return The staged copy, empty if the file could not be staged.
+			 */
+			std::string stageFile(const std::string& file);
+
+			/**
+			 * @brief Returns the size of the staged files.
+			 *
+			 * @return The size in bytes.
+			 */
+			uintmax_t size() const;
+
+		protected:
+			struct StagedFile
+			{
+				uintmax_t size = 0;
+				std::time_t lastUse = 0;
+			};
+
+			/**
+			 * @brief Reads the staged files from the cache directory and removes incomplete copies.
+			 */
+			void scan();
+
+			/**
+			 * @brief Evicts the least recently used files until the required bytes fit within the quota. Files staged
+			 *        for the current quiz are not evicted.
+			 *
+			 * @param[in] required The number of bytes required.
+			 *
+			 * @return True if the required bytes fit.
+			 */
+			bool evict(uintmax_t required);
+
+			/**
+			 * @brief Copies a file, by a reflink if the file system supports it.
+			 *
+			 * @param[in] source The source file.
+			 * @param[in] target The target file.
+			 */
+			static void copy(const std::string& source, const std::string& target);
+
+			/** Variables */
+			std::string _directory = "";
+			uintmax_t _quota = 0;
+			uintmax_t _size = 0;
+
+			/** Staged files by name */
+			std::map<std::string, StagedFile> _files;
+
+			/** Files staged for the current quiz */
+			std::set<std::string> _pinned;
+		};
+	}
+}
\ No newline at end of file
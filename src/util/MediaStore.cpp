@@ -0,0 +1,293 @@
+#include "MediaStore.hpp"
+
+#include <cctype>
+#include <vector>
+#include <locale>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+
+#include "common/Log.hpp"
+#include "common/HashUtil.hpp"
+#include "util/QuizPack.hpp"
+#include "util/QuizDocument.hpp"
+
+
+namespace {
+	/** Suffix of the files that are not completely added yet */
+	const std::string PARTIAL_SUFFIX = ".partial";
+
+	std::string normalize(const std::string& path)
+	{
+		return boost::filesystem::absolute(path).lexically_normal().generic_string();
+	}
+
+	bool isInDirectory(const std::string& file, const std::string& directory)
+	{
+		/** A trailing separator is normalized to "/." */
+		std::string normalizedDirectory = normalize(directory);
+		if ( normalizedDirectory.size() >= 2 && normalizedDirectory.compare(normalizedDirectory.size() - 2, 2, "/.") == 0 ) {
+			normalizedDirectory.pop_back();
+		} else if ( normalizedDirectory.empty() || normalizedDirectory.back() != '/' ) {
+			normalizedDirectory += '/';
+		}
+		return normalize(file).compare(0, normalizedDirectory.size(), normalizedDirectory) == 0;
+	}
+
+	bool isSameContent(const std::string& file, const std::string& otherFile)
+	{
+		std::ifstream stream(file, std::ios::binary);
+		std::ifstream otherStream(otherFile, std::ios::binary);
+		if ( !stream.is_open() || !otherStream.is_open() ) {
+			throw std::runtime_error("Failed to open '" + file + "' or '" + otherFile + "' for comparison.");
+		}
+
+		/** Compare in chunks */
+		std::vector<char> buffer(64 * 1024);
+		std::vector<char> otherBuffer(buffer.size());
+		while ( stream && otherStream ) {
+			stream.read(buffer.data(), buffer.size());
+			otherStream.read(otherBuffer.data(), otherBuffer.size());
+			if ( stream.gcount() != otherStream.gcount() || !std::equal(buffer.begin(), buffer.begin() + stream.gcount(), otherBuffer.begin()) ) {
+				return false;
+			}
+		}
+
+		return !stream && !otherStream;
+	}
+}
+
+
+std::string MusicQuiz::util::MediaStore::getStoreDirectory()
+{
+	return "./data/.media";
+}
+
+std::string MusicQuiz::util::MediaStore::add(const std::string& file, const bool move, const std::string& storeDirectory)
+{
+	bool alreadyStored = false;
+	return add(file, move, storeDirectory, alreadyStored);
+}
+
+std::string MusicQuiz::util::MediaStore::add(const std::string& file, const bool move, const std::string& storeDirectory, bool& alreadyStored)
+{
+	alreadyStored = true;
+	if ( contains(file, storeDirectory) ) {
+		return (boost::filesystem::path(storeDirectory) / boost::filesystem::path(file).filename()).generic_string();
+	}
+
+	/** Name */
+	std::string extension = boost::filesystem::path(file).extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](const char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+	const std::string name = common::HashUtil::hashFile(file) + extension;
+	const boost::filesystem::path storedFile = boost::filesystem::path(storeDirectory) / name;
+	const uintmax_t fileSize = boost::filesystem::file_size(file);
+
+	/** Stored, the content is compared such that a hash collision can never replace a media file */
+	boost::filesystem::create_directories(storeDirectory);
+	if ( boost::filesystem::exists(storedFile) ) {
+		if ( boost::filesystem::file_size(storedFile) != fileSize || !isSameContent(file, storedFile.string()) ) {
+			throw std::runtime_error("Stored media file '" + storedFile.string() + "' does not match '" + file + "'.");
+		}
+
+		if ( move ) {
+			boost::filesystem::remove(file);
+		}
+		return storedFile.generic_string();
+	}
+
+	/** Add, the file is renamed when complete such that an interrupted copy is never referenced */
+	alreadyStored = false;
+	const boost::filesystem::path partialFile = storedFile.string() + PARTIAL_SUFFIX;
+	boost::system::error_code error;
+	if ( move ) {
+		boost::filesystem::rename(file, storedFile, error);
+		if ( !error ) {
+			return storedFile.generic_string();
+		}
+	}
+
+	boost::filesystem::copy_file(file, partialFile, boost::filesystem::copy_option::overwrite_if_exists);
+	boost::filesystem::rename(partialFile, storedFile);
+	if ( move ) {
+		boost::filesystem::remove(file);
+	}
+	return storedFile.generic_string();
+}
+
+bool MusicQuiz::util::MediaStore::contains(const std::string& file, const std::string& storeDirectory)
+{
+	return isInDirectory(file, storeDirectory);
+}
+
+std::map<std::string, size_t> MusicQuiz::util::MediaStore::getReferenceCounts(const std::vector<std::string>& quizFiles, const std::string& storeDirectory)
+{
+	std::map<std::string, size_t> referenceCounts;
+	const auto addReference = [&](const std::string& file) {
+		if ( !file.empty() && contains(file, storeDirectory) ) {
+			++referenceCounts[boost::filesystem::path(file).filename().string()];
+		}
+	};
+
+	for ( const std::string& quizFile : quizFiles ) {
+		const MusicQuiz::util::QuizDocument::CPtr document = MusicQuiz::util::QuizDocument::load(quizFile);
+		for ( const MusicQuiz::util::QuizDocument::Category& category : document->categories ) {
+			for ( const MusicQuiz::util::QuizDocument::Entry& entry : category.entries ) {
+				addReference(entry.songFile);
+				addReference(entry.videoFile);
+			}
+		}
+	}
+
+	return referenceCounts;
+}
+
+size_t MusicQuiz::util::MediaStore::collectGarbage(const std::vector<std::string>& quizFiles, const std::string& storeDirectory)
+{
+	if ( !boost::filesystem::is_directory(storeDirectory) ) {
+		return 0;
+	}
+
+	/** References, a quiz that cannot be read aborts the collection */
+	const std::map<std::string, size_t> referenceCounts = getReferenceCounts(quizFiles, storeDirectory);
+
+	size_t removed = 0;
+	uintmax_t removedBytes = 0;
+	boost::system::error_code error;
+	for ( boost::filesystem::directory_iterator it(storeDirectory), end; it != end; ++it ) {
+		const boost::filesystem::path& path = it->path();
+		if ( !boost::filesystem::is_regular_file(path, error) || referenceCounts.count(path.filename().string()) > 0 ) {
+			continue;
+		}
+
+		const uintmax_t fileSize = boost::filesystem::file_size(path, error);
+		if ( boost::filesystem::remove(path, error) ) {
+			++removed;
+			removedBytes += fileSize;
+		}
+	}
+
+	LOG_INFO("Removed " << removed << " unreferenced media files (" << removedBytes / (1024 * 1024) << " MB) from '" << storeDirectory << "', "
+		<< referenceCounts.size() << " media files are referenced.");
+	return removed;
+}
+
+size_t MusicQuiz::util::MediaStore::release(const std::set<std::string>& storedFiles, const std::vector<std::string>& quizFiles, const std::string& storeDirectory)
+{
+	if ( storedFiles.empty() ) {
+		return 0;
+	}
+
+	/** References, a quiz that cannot be read aborts the removal */
+	const std::map<std::string, size_t> referenceCounts = getReferenceCounts(quizFiles, storeDirectory);
+
+	size_t removed = 0;
+	boost::system::error_code error;
+	for ( const std::string& storedFile : storedFiles ) {
+		if ( referenceCounts.count(storedFile) == 0 && boost::filesystem::remove(boost::filesystem::path(storeDirectory) / storedFile, error) ) {
+			++removed;
+		}
+	}
+
+	LOG_INFO("Removed " << removed << " of " << storedFiles.size() << " released media files from '" << storeDirectory << "'.");
+	return removed;
+}
+
+MusicQuiz::util::MediaStore::MigrationStatistics MusicQuiz::util::MediaStore::migrate(const std::string& quizFile, const std::string& storeDirectory)
+{
+	boost::property_tree::ptree tree;
+	boost::property_tree::read_xml(quizFile, tree, boost::property_tree::xml_parser::trim_whitespace);
+
+	/** Media files are copied to the store, the files in the media folder are removed once the quiz references the store */
+	const std::string mediaDirectory = (boost::filesystem::path(quizFile).parent_path() / "media").string();
+
+	MigrationStatistics statistics;
+	std::map<std::string, std::string> storedFiles;
+	std::vector<std::string> migratedFiles;
+	const auto migrateFile = [&](boost::property_tree::ptree& mediaTree, const std::string& field) {
+		boost::optional<boost::property_tree::ptree&> fileTree = mediaTree.get_child_optional(field);
+		if ( !fileTree ) {
+			return;
+		}
+
+		const std::string file = fileTree->get_value<std::string>();
+		if ( file.empty() || contains(file, storeDirectory) ) {
+			return;
+		}
+
+		auto it = storedFiles.find(file);
+		if ( it == storedFiles.end() ) {
+			if ( !boost::filesystem::exists(file) ) {
+				LOG_WARN("Media file '" << file << "' of quiz '" << quizFile << "' does not exist.");
+				return;
+			}
+
+			bool alreadyStored = false;
+			const uintmax_t fileSize = boost::filesystem::file_size(file);
+			const std::string storedFile = add(file, false, storeDirectory, alreadyStored);
+			if ( alreadyStored ) {
+				++statistics.duplicates;
+				statistics.duplicateBytes += fileSize;
+			}
+			if ( isInDirectory(file, mediaDirectory) ) {
+				migratedFiles.push_back(file);
+			}
+			it = storedFiles.emplace(file, storedFile).first;
+			++statistics.files;
+		}
+		fileTree->put_value(it->second);
+	};
+
+	boost::optional<boost::property_tree::ptree&> categoriesTree = tree.get_child_optional("MusicQuiz.QuizCategories");
+	if ( categoriesTree ) {
+		for ( auto& category : *categoriesTree ) {
+			for ( auto& entry : category.second ) {
+				boost::optional<boost::property_tree::ptree&> mediaTree = entry.second.get_child_optional("Media");
+				if ( mediaTree ) {
+					migrateFile(*mediaTree, "SongFile");
+					migrateFile(*mediaTree, "VideoFile");
+				}
+			}
+		}
+	}
+
+	if ( statistics.files == 0 ) {
+		return statistics;
+	}
+
+	/** Write to a temporary file and replace the quiz such that it is never left half written */
+#if ( BOOST_VERSION >= 105600 )
+	boost::property_tree::xml_writer_settings<std::string> settings('\t', 1);
+#else
+	boost::property_tree::xml_writer_settings<char> settings('\t', 1);
+#endif
+	const std::string tmpFile = quizFile + ".tmp";
+	boost::property_tree::write_xml(tmpFile, tree, std::locale(), settings);
+	boost::filesystem::rename(tmpFile, quizFile);
+
+	/** The quiz references the store, the migrated media files and the pack containing them are no longer used */
+	boost::system::error_code error;
+	boost::filesystem::remove(MusicQuiz::util::QuizPack::getPackFile(quizFile), error);
+	for ( const std::string& file : migratedFiles ) {
+		boost::filesystem::remove(file, error);
+	}
+
+	/** Remove the media folder once it only contains empty folders */
+	if ( boost::filesystem::is_directory(mediaDirectory, error) ) {
+		bool empty = true;
+		for ( boost::filesystem::recursive_directory_iterator it(mediaDirectory), end; it != end && empty; ++it ) {
+			empty = !boost::filesystem::is_regular_file(it->path(), error);
+		}
+		if ( empty ) {
+			boost::filesystem::remove_all(mediaDirectory, error);
+		}
+	}
+
+	LOG_INFO("Migrated " << statistics.files << " media files of quiz '" << quizFile << "' to '" << storeDirectory << "', "
+		<< statistics.duplicates << " were already stored.");
+	return statistics;
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Content addressed store of the media files shared by all quizzes.
+		 *
+		 * A media file is stored once as ./data/.media/<hash><extension>, where the hash is the hash of its content,
+		 * and the quizzes reference the stored file instead of a copy in their media folder. A stored file is removed
+		 * by the garbage collection once no quiz references it.
+		 */
+		class MediaStore
+		{
+		public:
+			struct MigrationStatistics
+			{
+				size_t files = 0;
+				size_t duplicates = 0;
+				uintmax_t duplicateBytes = 0;
+			};
+
+			/**
+			 * @brief Deleted constructor.
+			 */
+			MediaStore() = delete;
+
+			/**
+			 * @brief Deleted Destructor.
+			 */
+			~MediaStore() = delete;
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			MediaStore(const MediaStore&) = delete;
+			MediaStore& operator=(const MediaStore&) = delete;
+
+			/**
+			 * @brief Returns the default store directory.
+			 *
+			 * @return The store directory.
+			 */
+			static std::string getStoreDirectory();
+
+			/**
+			 * @brief Adds a media file to the store. If the content is already stored the stored file is reused.
+			 *
+			 * @param[in] file The media file.
+			 * @param[in] move If true the media file is moved to the store, or removed if the content is already stored.
+			 * @param[in] storeDirectory The store directory.
+			 *
+			 * @return The stored file.
+			 */
+			static std::string add(const std::string& file, bool move = false, const std::string& storeDirectory = getStoreDirectory());
+
+			/**
+			 * @brief Adds a media file to the store. If the content is already stored the stored file is reused.
+			 *
+			 * @param[in] file The media file.
+			 * @param[in] move If true the media file is moved to the store, or removed if the content is already stored.
+			 * @param[in] storeDirectory The store directory.
+			 * @param[out] alreadyStored True if the content was already stored.
+			 *
+			 * @return The stored file.
+			 */
+			static std::string add(const std::string& file, bool move, const std::string& storeDirectory, bool& alreadyStored);
+
+			/**
+			 * @brief Checks if a media file is in the store.
+			 *
+			 * @param[in] file The media file.
+			 * @param[in] storeDirectory The store directory.
+			 *
+			 * @return True if the file is in the store.
+			 */
+			static bool contains(const std::string& file, const std::string& storeDirectory = getStoreDirectory());
+
+			/**
+			 * @brief Counts the references of the quizzes to the stored files.
+			 *
+			 * @param[in] quizFiles The quiz files.
+			 * @param[in] storeDirectory The store directory.
+			 *
+			 * @return The number of references by stored file name.
+			 */
+			static std::map<std::string, size_t> getReferenceCounts(const std::vector<std::string>& quizFiles, const std::string& storeDirectory = getStoreDirectory());
+
+			/**
+			 * @brief Removes the stored files that are not referenced by any quiz. Nothing is removed if a quiz cannot be
+			 *        read, as its references are unknown.
+			 *
+			 * @param[in] quizFiles The quiz files, all quizzes using the store.
+			 * @param[in] storeDirectory The store directory.
+			 *
+			 * @return The number of removed files.
+			 */
+			static size_t collectGarbage(const std::vector<std::string>& quizFiles, const std::string& storeDirectory = getStoreDirectory());
+
+			/**
+			 * @brief Removes stored files that are no longer referenced by a quiz, e.g. the files the previous version
+			 *        of a saved quiz referenced. A file is kept if any of the quizzes references it.
+			 *
+			 * @param[in] storedFiles The names of the stored files.
+			 * @param[in] quizFiles The quiz files that may reference the stored files.
+			 * @param[in] storeDirectory The store directory.
+			 *
+			 * @return The number of removed files.
+			 */
+			static size_t release(const std::set<std::string>& storedFiles, const std::vector<std::string>& quizFiles, const std::string& storeDirectory = getStoreDirectory());
+
+			/**
+			 * @brief Copies the media files of a quiz to the store and rewrites the quiz file to reference the stored
+			 *        files. The media files in the media folder of the quiz and its stale pack are removed once the
+			 *        quiz file is replaced, such that a failed migration leaves the quiz untouched.
+			 *
+			 * @param[in] quizFile The quiz file.
+			 * @param[in] storeDirectory The store directory.
+			 *
+			 * @return The migration statistics.
+			 */
+			static MigrationStatistics migrate(const std::string& quizFile, const std::string& storeDirectory = getStoreDirectory());
+		};
+	}
+}
\ No newline at end of file
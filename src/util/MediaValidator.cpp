@@ -0,0 +1,153 @@
+#include "MediaValidator.hpp"
+
+#include <mutex>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+
+#include <boost/filesystem.hpp>
+
+#include "common/HashUtil.hpp"
+#include "util/QuizPack.hpp"
+
+
+namespace {
+	/** Number of files checked by a worker at a time */
+	constexpr size_t BATCH_SIZE = 32;
+
+	/** Maximum number of workers, the checks wait on the drive rather than the CPU */
+	constexpr size_t MAX_WORKERS = 8;
+
+	struct CachedReport
+	{
+		uint64_t stamp = 0;
+		MusicQuiz::util::MissingMediaReport report;
+	};
+
+	std::mutex reportCacheMutex;
+	std::unordered_map<std::string, CachedReport> reportCache;
+
+	uint64_t getDirectoryStamp(const std::vector<std::string_view>& files, const bool packed)
+	{
+		/** Adding, removing or renaming a media file changes the modification time of its directory. The files are
+		    sorted such that the files of a directory are next to each other. */
+		uint64_t stamp = common::HashUtil::hashBytes(&packed, sizeof(packed));
+		std::string_view previousDirectory;
+		for ( const std::string_view& file : files ) {
+			const std::string_view directory = file.substr(0, file.find_last_of('/') == std::string_view::npos ? 0 : file.find_last_of('/'));
+			if ( directory == previousDirectory ) {
+				continue;
+			}
+			previousDirectory = directory;
+
+			boost::system::error_code error;
+			const std::time_t lastWriteTime = boost::filesystem::last_write_time(std::string(directory), error);
+			const int64_t time = error ? -1 : static_cast<int64_t>(lastWriteTime);
+			stamp = common::HashUtil::hashBytes(directory.data(), directory.size(), stamp);
+			stamp = common::HashUtil::hashBytes(&time, sizeof(time), stamp);
+		}
+		return stamp;
+	}
+}
+
+
+std::vector<bool> MusicQuiz::util::MediaValidator::exists(const std::vector<std::string>& files)
+{
+	/** Results are stored as chars such that workers can write them concurrently */
+	std::vector<char> results(files.size(), 0);
+	std::atomic<size_t> nextBatch(0);
+	const size_t numberOfBatches = (files.size() + BATCH_SIZE - 1) / BATCH_SIZE;
+	const auto worker = [&]() {
+		for ( size_t batch = nextBatch++; batch < numberOfBatches; batch = nextBatch++ ) {
+			const size_t end = std::min(files.size(), (batch + 1) * BATCH_SIZE);
+			for ( size_t i = batch * BATCH_SIZE; i < end; ++i ) {
+				boost::system::error_code error;
+				results[i] = boost::filesystem::exists(files[i], error) && !error;
+			}
+		}
+	};
+
+	/** Workers, the calling thread works as well */
+	const size_t numberOfWorkers = std::min({ numberOfBatches, MAX_WORKERS, static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency())) });
+	std::vector<std::future<void>> workers;
+	for ( size_t i = 1; i < numberOfWorkers; ++i ) {
+		workers.push_back(std::async(std::launch::async, worker));
+	}
+	worker();
+
+	for ( size_t i = 0; i < workers.size(); ++i ) {
+		workers[i].get();
+	}
+
+	return std::vector<bool>(results.begin(), results.end());
+}
+
+MusicQuiz::util::MissingMediaReport MusicQuiz::util::MediaValidator::validate(const MusicQuiz::util::QuizModel& model)
+{
+	/** Media Files, deduplicated and without the files in the quiz pack */
+	std::vector<std::string_view> files;
+	const auto addFile = [&](const std::string_view& file) {
+		if ( model.quizPack == nullptr || !model.quizPack->contains(std::string(file)) ) {
+			files.push_back(file);
+		}
+	};
+
+	for ( const MusicQuiz::util::QuizModel::Category& category : model.categories ) {
+		for ( const MusicQuiz::util::QuizModel::Entry& entry : category.entries ) {
+			addFile(entry.songFile);
+			if ( entry.type == MusicQuiz::util::QuizModel::EntryType::VIDEO ) {
+				addFile(entry.videoFile);
+			}
+		}
+	}
+
+	std::sort(files.begin(), files.end());
+	files.erase(std::unique(files.begin(), files.end()), files.end());
+
+	/** Cached Report */
+	const uint64_t stamp = getDirectoryStamp(files, model.quizPack != nullptr);
+	{
+		std::lock_guard<std::mutex> lock(reportCacheMutex);
+		const auto it = reportCache.find(model.quizId);
+		if ( it != reportCache.end() && it->second.stamp == stamp ) {
+			return it->second.report;
+		}
+	}
+
+	/** Check Files */
+	const std::vector<bool> fileExists = exists(std::vector<std::string>(files.begin(), files.end()));
+
+	/** Report */
+	MusicQuiz::util::MissingMediaReport report;
+	report.checkedFiles = files.size();
+	const auto checkFile = [&](const MusicQuiz::util::QuizModel::Category& category, const MusicQuiz::util::QuizModel::Entry& entry,
+		const MusicQuiz::util::MissingMediaReport::MediaType type, const std::string_view& file) {
+		const auto it = std::lower_bound(files.begin(), files.end(), file);
+		if ( it != files.end() && *it == file && !fileExists[static_cast<size_t>(it - files.begin())] ) {
+			MusicQuiz::util::MissingMediaReport::MissingMedia media;
+			media.category = category.name;
+			media.answer = std::string(entry.answer);
+			media.type = type;
+			media.mediaFile = std::string(file);
+			report.missingMedia.push_back(media);
+		}
+	};
+
+	for ( const MusicQuiz::util::QuizModel::Category& category : model.categories ) {
+		for ( const MusicQuiz::util::QuizModel::Entry& entry : category.entries ) {
+			checkFile(category, entry, MusicQuiz::util::MissingMediaReport::MediaType::SONG, entry.songFile);
+			if ( entry.type == MusicQuiz::util::QuizModel::EntryType::VIDEO ) {
+				checkFile(category, entry, MusicQuiz::util::MissingMediaReport::MediaType::VIDEO, entry.videoFile);
+			}
+		}
+	}
+
+	/** Add to Cache */
+	std::lock_guard<std::mutex> lock(reportCacheMutex);
+	reportCache[model.quizId] = { stamp, report };
+
+	return report;
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "util/QuizModel.hpp"
+#include "util/MissingMediaReport.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Checks the media files of a quiz in a single batched pass.
+		 *
+		 * The media files are deduplicated and checked in parallel, such that slow or network mounted drives do not
+		 * serialize a stat per entry. The report is cached per quiz id and reused while the directories containing
+		 * the media files are unchanged.
+		 */
+		class MediaValidator
+		{
+		public:
+			/**
+			 * @brief Deleted constructor.
+			 */
+			MediaValidator() = delete;
+
+			/**
+			 * @brief Deleted Destructor.
+			 */
+			~MediaValidator() = delete;
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			MediaValidator(const MediaValidator&) = delete;
+			MediaValidator& operator=(const MediaValidator&) = delete;
+
+			/**
+			 * @brief Checks if files exist. The files are checked in batches on worker threads.
+			 *
+			 * @param[in] files The files.
+			 *
+			 * @return For each file true if it exists.
+			 */
+			static std::vector<bool> exists(const std::vector<std::string>& files);
+
+			/**
+			 * @brief Validates the media files of a quiz. Media files in the quiz pack are not checked on disk.
+			 *
+			 * @param[in] model The quiz model.
+			 *
+			 * @return The missing media report.
+			 */
+			static MusicQuiz::util::MissingMediaReport validate(const MusicQuiz::util::QuizModel& model);
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <iostream>
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief The media files of a quiz that could not be found.
+		 */
+		struct MissingMediaReport
+		{
+			enum class MediaType
+			{
+				SONG, VIDEO
+			};
+
+			struct MissingMedia
+			{
+				std::string category = "";
+				std::string answer = "";
+				MediaType type = MediaType::SONG;
+				std::string mediaFile = "";
+			};
+
+			/** Number of distinct media files that were checked */
+			size_t checkedFiles = 0;
+
+			std::vector<MissingMedia> missingMedia;
+
+			bool empty() const
+			{
+				return missingMedia.empty();
+			}
+
+			friend std::ostream& operator<<(std::ostream& out, const MissingMediaReport& report)
+			{
+				for ( size_t i = 0; i < report.missingMedia.size(); ++i ) {
+					const MissingMedia& media = report.missingMedia[i];
+					out << "Missing " << (media.type == MediaType::SONG ? "song" : "video") << " file '" << media.mediaFile << "' ("
+						<< media.category << " - " << media.answer << ")\n";
+				}
+				return out;
+			}
+		};
+	}
+}
\ No newline at end of file
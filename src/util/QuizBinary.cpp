@@ -0,0 +1,321 @@
+#include "QuizBinary.hpp"
+
+#include <vector>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <boost/filesystem.hpp>
+
+#include "common/Log.hpp"
+#include "common/HashUtil.hpp"
+
+
+namespace {
+	/** Version of the compiled quiz format */
+	constexpr uint32_t BINARY_VERSION = 1;
+
+	/** Header Flags */
+	constexpr uint32_t FLAG_GUESS_THE_CATEGORY = 1;
+
+	/** Fields that might be missing, stored as a bit mask */
+	const std::vector<std::string> HEADER_FIELDS = { "QuizName", "QuizAuthor", "QuizDescription", "QuizCategories.Category.<xmlattr>.name" };
+	const std::vector<std::string> ENTRY_FIELDS = { "<xmlattr>.name", "<xmlattr>.type", "Answer", "Points", "StartTime", "VideoSongStartTime",
+		"AnswerStartTime", "Media.SongFile", "Media.VideoFile" };
+
+	static_assert(sizeof(MusicQuiz::util::QuizBinary::Header) == 104, "Unexpected compiled quiz header size.");
+	static_assert(sizeof(MusicQuiz::util::QuizBinary::CategoryRecord) == 16, "Unexpected compiled quiz category size.");
+	static_assert(sizeof(MusicQuiz::util::QuizBinary::EntryRecord) == 80, "Unexpected compiled quiz entry size.");
+
+	uint32_t toMask(const std::vector<std::string>& missingFields, const std::vector<std::string>& fields)
+	{
+		uint32_t mask = 0;
+		for ( size_t i = 0; i < fields.size(); ++i ) {
+			for ( size_t j = 0; j < missingFields.size(); ++j ) {
+				if ( missingFields[j] == fields[i] ) {
+					mask |= 1u << i;
+				}
+			}
+		}
+		return mask;
+	}
+
+	class StringTable
+	{
+	public:
+		MusicQuiz::util::QuizBinary::StringRef add(const std::string& str)
+		{
+			/** Identical strings are only stored once */
+			const auto it = _refs.find(str);
+			if ( it != _refs.end() ) {
+				return it->second;
+			}
+
+			MusicQuiz::util::QuizBinary::StringRef ref;
+			ref.offset = static_cast<uint32_t>(_data.size());
+			ref.size = static_cast<uint32_t>(str.size());
+			_data.insert(_data.end(), str.begin(), str.end());
+			_refs.emplace(str, ref);
+			return ref;
+		}
+
+		const std::vector<char>& data() const
+		{
+			return _data;
+		}
+
+	private:
+		std::vector<char> _data;
+		std::unordered_map<std::string, MusicQuiz::util::QuizBinary::StringRef> _refs;
+	};
+
+	template <typename T>
+	void append(std::vector<char>& buffer, const T* data, const size_t count)
+	{
+		const char* bytes = reinterpret_cast<const char*>(data);
+		buffer.insert(buffer.end(), bytes, bytes + sizeof(T) * count);
+	}
+}
+
+
+MusicQuiz::util::QuizBinary::~QuizBinary()
+{
+	if ( _data != nullptr ) {
+		_file.unmap(const_cast<uchar*>(_data));
+	}
+}
+
+MusicQuiz::util::QuizBinary::Ptr MusicQuiz::util::QuizBinary::open(const std::string& binaryFile, const std::string& sourceHash)
+{
+	/** Map File */
+	QuizBinary::Ptr binary = std::make_shared<QuizBinary>();
+	binary->_file.setFileName(QString::fromStdString(binaryFile));
+	if ( !binary->_file.exists() || !binary->_file.open(QIODevice::ReadOnly) ) {
+		return nullptr;
+	}
+
+	binary->_size = static_cast<size_t>(binary->_file.size());
+	if ( binary->_size < sizeof(Header) ) {
+		return nullptr;
+	}
+
+	binary->_data = binary->_file.map(0, binary->_file.size());
+	if ( binary->_data == nullptr ) {
+		LOG_WARN("Failed to map compiled quiz '" << binaryFile << "'. " << binary->_file.errorString().toStdString());
+		return nullptr;
+	}
+
+	/** Validate */
+	if ( !binary->validate(sourceHash) ) {
+		return nullptr;
+	}
+
+	return binary;
+}
+
+bool MusicQuiz::util::QuizBinary::validate(const std::string& sourceHash) const
+{
+	const Header& header = getHeader();
+
+	/** Magic, Version & Source */
+	const Header expected;
+	if ( std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != BINARY_VERSION ) {
+		return false;
+	}
+
+	if ( sourceHash.size() != sizeof(header.sourceHash) || std::memcmp(header.sourceHash, sourceHash.data(), sizeof(header.sourceHash)) != 0 ) {
+		return false;
+	}
+
+	/** Sections */
+	const auto inFile = [this](const uint64_t offset, const uint64_t size) { return offset % 8 == 0 && offset + size <= _size; };
+	if ( !inFile(header.categoryOffset, uint64_t(header.categoryCount) * sizeof(CategoryRecord)) ||
+		!inFile(header.entryOffset, uint64_t(header.entryCount) * sizeof(EntryRecord)) ||
+		!inFile(header.rowCategoryOffset, uint64_t(header.rowCategoryCount) * sizeof(StringRef)) ||
+		!inFile(header.stringTableOffset, header.stringTableSize) ) {
+		return false;
+	}
+
+	/** Checksum */
+	if ( common::HashUtil::hashBytes(_data + sizeof(Header), _size - sizeof(Header)) != header.payloadHash ) {
+		return false;
+	}
+
+	/** String References */
+	const auto validRef = [&header](const StringRef& ref) { return uint64_t(ref.offset) + ref.size <= header.stringTableSize; };
+	if ( !validRef(header.quizName) || !validRef(header.quizAuthor) || !validRef(header.quizDescription) ) {
+		return false;
+	}
+
+	for ( size_t i = 0; i < header.categoryCount; ++i ) {
+		const CategoryRecord& category = getCategory(i);
+		if ( !validRef(category.name) || uint64_t(category.firstEntry) + category.entryCount > header.entryCount ) {
+			return false;
+		}
+	}
+
+	for ( size_t i = 0; i < header.entryCount; ++i ) {
+		const EntryRecord& entry = getEntry(i);
+		if ( !validRef(entry.name) || !validRef(entry.answer) || !validRef(entry.type) || !validRef(entry.songFile) || !validRef(entry.videoFile) ) {
+			return false;
+		}
+	}
+
+	const StringRef* rowCategories = reinterpret_cast<const StringRef*>(_data + header.rowCategoryOffset);
+	for ( size_t i = 0; i < header.rowCategoryCount; ++i ) {
+		if ( !validRef(rowCategories[i]) ) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void MusicQuiz::util::QuizBinary::write(const MusicQuiz::util::QuizDocument& document, const std::string& sourceHash, const std::string& binaryFile)
+{
+	/** Sanity Check */
+	Header header;
+	if ( sourceHash.size() != sizeof(header.sourceHash) ) {
+		throw std::runtime_error("Invalid source hash for compiled quiz.");
+	}
+
+	/** Header */
+	StringTable strings;
+	header.version = BINARY_VERSION;
+	header.flags = document.guessTheCategory ? FLAG_GUESS_THE_CATEGORY : 0;
+	std::memcpy(header.sourceHash, sourceHash.data(), sizeof(header.sourceHash));
+	header.missingFields = toMask(document.missingFields, HEADER_FIELDS);
+	header.quizName = strings.add(document.quizName);
+	header.quizAuthor = strings.add(document.quizAuthor);
+	header.quizDescription = strings.add(document.quizDescription);
+
+	/** Categories & Entries */
+	std::vector<CategoryRecord> categories;
+	std::vector<EntryRecord> entries;
+	for ( const MusicQuiz::util::QuizDocument::Category& category : document.categories ) {
+		CategoryRecord categoryRecord;
+		categoryRecord.name = strings.add(category.name);
+		categoryRecord.firstEntry = static_cast<uint32_t>(entries.size());
+		categoryRecord.entryCount = static_cast<uint32_t>(category.entries.size());
+		categories.push_back(categoryRecord);
+
+		for ( const MusicQuiz::util::QuizDocument::Entry& entry : category.entries ) {
+			EntryRecord entryRecord;
+			entryRecord.name = strings.add(entry.name);
+			entryRecord.answer = strings.add(entry.answer);
+			entryRecord.type = strings.add(entry.type);
+			entryRecord.songFile = strings.add(entry.songFile);
+			entryRecord.videoFile = strings.add(entry.videoFile);
+			entryRecord.missingFields = toMask(entry.missingFields, ENTRY_FIELDS);
+			entryRecord.points = entry.points;
+			entryRecord.startTime = entry.startTime;
+			entryRecord.videoSongStartTime = entry.videoSongStartTime;
+			entryRecord.answerStartTime = entry.answerStartTime;
+			entries.push_back(entryRecord);
+		}
+	}
+
+	/** Row Categories */
+	std::vector<StringRef> rowCategories;
+	for ( size_t i = 0; i < document.rowCategories.size(); ++i ) {
+		rowCategories.push_back(strings.add(document.rowCategories[i]));
+	}
+
+	/** Payload, every section starts at a multiple of 8 bytes */
+	std::vector<char> payload;
+	const auto align = [&payload]() { payload.resize((payload.size() + 7) & ~size_t(7), '\0'); };
+
+	header.categoryOffset = static_cast<uint32_t>(sizeof(Header) + payload.size());
+	header.categoryCount = static_cast<uint32_t>(categories.size());
+	append(payload, categories.data(), categories.size());
+
+	header.entryOffset = static_cast<uint32_t>(sizeof(Header) + payload.size());
+	header.entryCount = static_cast<uint32_t>(entries.size());
+	append(payload, entries.data(), entries.size());
+
+	header.rowCategoryOffset = static_cast<uint32_t>(sizeof(Header) + payload.size());
+	header.rowCategoryCount = static_cast<uint32_t>(rowCategories.size());
+	append(payload, rowCategories.data(), rowCategories.size());
+	align();
+
+	header.stringTableOffset = static_cast<uint32_t>(sizeof(Header) + payload.size());
+	header.stringTableSize = static_cast<uint32_t>(strings.data().size());
+	payload.insert(payload.end(), strings.data().begin(), strings.data().end());
+
+	header.payloadHash = common::HashUtil::hashBytes(payload.data(), payload.size());
+
+	/** Write to a temporary file and replace the compiled quiz such that it is never left half written */
+	const std::string tmpFile = binaryFile + ".tmp";
+	{
+		std::ofstream file(tmpFile, std::ios::binary | std::ios::trunc);
+		if ( !file.is_open() ) {
+			throw std::runtime_error("Failed to open '" + tmpFile + "' for writing.");
+		}
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+		file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+		if ( !file ) {
+			throw std::runtime_error("Failed to write '" + tmpFile + "'.");
+		}
+	}
+	boost::filesystem::rename(tmpFile, binaryFile);
+}
+
+std::string MusicQuiz::util::QuizBinary::getBinaryFile(const std::string& quizFile)
+{
+	const std::string extension = ".xml";
+	if ( quizFile.size() > extension.size() && quizFile.compare(quizFile.size() - extension.size(), extension.size(), extension) == 0 ) {
+		return quizFile.substr(0, quizFile.size() - extension.size()) + ".bin";
+	}
+	return quizFile + ".bin";
+}
+
+const MusicQuiz::util::QuizBinary::Header& MusicQuiz::util::QuizBinary::getHeader() const
+{
+	return *reinterpret_cast<const Header*>(_data);
+}
+
+const MusicQuiz::util::QuizBinary::CategoryRecord& MusicQuiz::util::QuizBinary::getCategory(const size_t idx) const
+{
+	if ( idx >= getHeader().categoryCount ) {
+		throw std::runtime_error("Index out of range.");
+	}
+	return reinterpret_cast<const CategoryRecord*>(_data + getHeader().categoryOffset)[idx];
+}
+
+const MusicQuiz::util::QuizBinary::EntryRecord& MusicQuiz::util::QuizBinary::getEntry(const size_t idx) const
+{
+	if ( idx >= getHeader().entryCount ) {
+		throw std::runtime_error("Index out of range.");
+	}
+	return reinterpret_cast<const EntryRecord*>(_data + getHeader().entryOffset)[idx];
+}
+
+std::string_view MusicQuiz::util::QuizBinary::getRowCategory(const size_t idx) const
+{
+	if ( idx >= getHeader().rowCategoryCount ) {
+		throw std::runtime_error("Index out of range.");
+	}
+	return getString(reinterpret_cast<const StringRef*>(_data + getHeader().rowCategoryOffset)[idx]);
+}
+
+std::string_view MusicQuiz::util::QuizBinary::getString(const StringRef& ref) const
+{
+	return std::string_view(reinterpret_cast<const char*>(_data + getHeader().stringTableOffset + ref.offset), ref.size);
+}
+
+bool MusicQuiz::util::QuizBinary::hasField(const EntryRecord& entry, const std::string_view field)
+{
+	for ( size_t i = 0; i < ENTRY_FIELDS.size(); ++i ) {
+		if ( ENTRY_FIELDS[i] == field ) {
+			return (entry.missingFields & (1u << i)) == 0;
+		}
+	}
+	return true;
+}
+
+bool MusicQuiz::util::QuizBinary::isGuessTheCategory() const
+{
+	return (getHeader().flags & FLAG_GUESS_THE_CATEGORY) != 0;
+}
\ No newline at end of file
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <string_view>
+
+#include <QFile>
+
+#include "util/QuizDocument.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Compiled binary representation of a quiz file, stored next to the quiz as '<Name>.quiz.bin'.
+		 *
+		 * The file consists of a header, fixed-size category and entry records, the row categories and a string
+		 * table. Strings are referenced by offset and size into the string table, such that the file can be memory
+		 * mapped and read without parsing and without allocating per entry. The XML file remains the source of truth,
+		 * the header stores the content hash of the XML file it was compiled from and the compiled file is ignored if
+		 * the hash does not match.
+		 *
+		 * The records are stored in the little-endian layout of the structs below.
+		 */
+		class QuizBinary
+		{
+		public:
+			struct StringRef
+			{
+				uint32_t offset = 0;
+				uint32_t size = 0;
+			};
+
+			struct Header
+			{
+				char magic[8] = { 'M', 'Q', 'U', 'I', 'Z', 'B', 'I', 'N' };
+				uint32_t version = 0;
+				uint32_t flags = 0;
+				char sourceHash[16] = {};
+				uint64_t payloadHash = 0;
+				uint32_t missingFields = 0;
+				uint32_t categoryCount = 0;
+				uint32_t entryCount = 0;
+				uint32_t rowCategoryCount = 0;
+				uint32_t categoryOffset = 0;
+				uint32_t entryOffset = 0;
+				uint32_t rowCategoryOffset = 0;
+				uint32_t stringTableOffset = 0;
+				uint32_t stringTableSize = 0;
+				uint32_t reserved = 0;
+				StringRef quizName;
+				StringRef quizAuthor;
+				StringRef quizDescription;
+			};
+
+			struct CategoryRecord
+			{
+				StringRef name;
+				uint32_t firstEntry = 0;
+				uint32_t entryCount = 0;
+			};
+
+			struct EntryRecord
+			{
+				StringRef name;
+				StringRef answer;
+				StringRef type;
+				StringRef songFile;
+				StringRef videoFile;
+				uint32_t missingFields = 0;
+				uint32_t reserved = 0;
+				uint64_t points = 0;
+				uint64_t startTime = 0;
+				uint64_t videoSongStartTime = 0;
+				uint64_t answerStartTime = 0;
+			};
+
+			/**
+			 * @brief Shared Pointer
+			 */
+			typedef std::shared_ptr< QuizBinary > Ptr;
+			typedef std::shared_ptr< const QuizBinary > CPtr;
+
+			/**
+			 * @brief Constructor, use open to map a compiled quiz.
+			 */
+			QuizBinary() = default;
+
+			/**
+			 * @brief Destructor, unmaps the file.
+			 */
+			virtual ~QuizBinary();
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			QuizBinary(const QuizBinary&) = delete;
+			QuizBinary& operator=(const QuizBinary&) = delete;
+
+			/**
+			 * @brief Memory maps and validates a compiled quiz.
+			 *
+			 * @param[in] binaryFile The compiled quiz file.
+			 * @param[in] sourceHash The content hash of the XML file.
+			 *
+			 * @return The compiled quiz or nullptr if the file is missing, invalid or compiled from another version of
+			 *         the XML file.
+			 */
+			static Ptr open(const std::string& binaryFile, const std::string& sourceHash);
+
+			/**
+			 * @brief Compiles a quiz document. The file is written to a temporary file and renamed.
+			 *
+			 * @param[in] document The quiz document.
+			 * @param[in] sourceHash The content hash of the XML file the document was parsed from.
+			 * @param[in] binaryFile The compiled quiz file.
+			 */
+			static void write(const MusicQuiz::util::QuizDocument& document, const std::string& sourceHash, const std::string& binaryFile);
+
+			/**
+			 * @brief Returns the compiled quiz file of a quiz file.
+			 *
+			 * @param[in] quizFile The quiz file.
+			 *
+			 * @return The compiled quiz file.
+			 */
+			static std::string getBinaryFile(const std::string& quizFile);
+
+			/**
+			 * @brief Returns the header.
+			 *
+			 * @return The header.
+			 */
+			const Header& getHeader() const;
+
+			/**
+			 * @brief Returns a category record.
+			 *
+			 * @param[in] idx The category index.
+			 *
+			 * @return The category record.
+			 */
+			const CategoryRecord& getCategory(size_t idx) const;
+
+			/**
+			 * @brief Returns an entry record.
+			 *
+			 * @param[in] idx The entry index.
+			 *
+			 * @return The entry record.
+			 */
+			const EntryRecord& getEntry(size_t idx) const;
+
+			/**
+			 * @brief Returns a row category.
+			 *
+			 * @param[in] idx The row category index.
+			 *
+			 * @return The row category.
+			 */
+			std::string_view getRowCategory(size_t idx) const;
+
+			/**
+			 * @brief Returns a string from the string table.
+			 *
+			 * @param[in] ref The string reference.
+			 *
+			 * @return The string.
+			 */
+			std::string_view getString(const StringRef& ref) const;
+
+			/**
+			 * @brief Checks if a field of an entry was present in the quiz file.
+			 *
+			 * @param[in] entry The entry record.
+			 * @param[in] field The field name, e.g. 'Points' or 'Media.SongFile'.
+			 *
+			 * @return True if the field was present.
+			 */
+			static bool hasField(const EntryRecord& entry, std::string_view field);
+
+			/**
+			 * @brief Returns true if guess the category is enabled.
+			 *
+			 * @return True if guess the category is enabled.
+			 */
+			bool isGuessTheCategory() const;
+
+		private:
+			/**
+			 * @brief Validates the mapped file.
+			 *
+			 * @param[in] sourceHash The content hash of the XML file.
+			 *
+			 * @return True if the file is valid.
+			 */
+			bool validate(const std::string& sourceHash) const;
+
+			/** Variables */
+			QFile _file;
+			const uchar* _data = nullptr;
+			size_t _size = 0;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,502 @@
+#include "QuizCatalog.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+
+#include "common/Log.hpp"
+#include "common/HashUtil.hpp"
+#include "util/QuizLoader.hpp"
+
+
+namespace {
+	/** Version of the catalog file format */
+	constexpr size_t CATALOG_VERSION = 2;
+
+	/** Depth of the quiz folders below the data folder, deeper folders are not listed */
+	constexpr size_t MAX_DISCOVERY_DEPTH = 1;
+
+	/** Extension of quiz files */
+	const std::string QUIZ_FILE_EXTENSION = ".quiz.xml";
+
+	bool isQuizFile(const std::string& fileName)
+	{
+		return fileName.size() > QUIZ_FILE_EXTENSION.size() &&
+			fileName.compare(fileName.size() - QUIZ_FILE_EXTENSION.size(), QUIZ_FILE_EXTENSION.size(), QUIZ_FILE_EXTENSION) == 0;
+	}
+
+	bool isHiddenDirectory(const std::string& directoryName)
+	{
+		return directoryName.empty() || directoryName.front() == '.';
+	}
+
+	void writePreview(boost::property_tree::ptree& tree, const MusicQuiz::util::QuizPreview& preview)
+	{
+		tree.put("QuizName", preview.quizName);
+		tree.put("QuizAuthor", preview.quizAuthor);
+		tree.put("QuizDescription", preview.quizDescription);
+		tree.put("IncludeSongs", preview.includeSongs);
+		tree.put("IncludeVideos", preview.includeVideos);
+		tree.put("GuessTheCategory", preview.guessTheCategory);
+		for ( size_t i = 0; i < preview.categories.size(); ++i ) {
+			tree.add("Category", preview.categories[i]);
+		}
+		for ( size_t i = 0; i < preview.rowCategories.size(); ++i ) {
+			tree.add("RowCategory", preview.rowCategories[i]);
+		}
+	}
+
+	MusicQuiz::util::QuizPreview readPreview(const boost::property_tree::ptree& tree)
+	{
+		MusicQuiz::util::QuizPreview preview;
+		preview.quizName = tree.get<std::string>("QuizName", "");
+		preview.quizAuthor = tree.get<std::string>("QuizAuthor", "");
+		preview.quizDescription = tree.get<std::string>("QuizDescription", "");
+		preview.includeSongs = tree.get("IncludeSongs", false);
+		preview.includeVideos = tree.get("IncludeVideos", false);
+		preview.guessTheCategory = tree.get("GuessTheCategory", false);
+		for ( const auto& child : tree ) {
+			if ( child.first == "Category" ) {
+				preview.categories.push_back(child.second.data());
+			} else if ( child.first == "RowCategory" ) {
+				preview.rowCategories.push_back(child.second.data());
+			}
+		}
+		return preview;
+	}
+}
+
+
+MusicQuiz::util::QuizCatalog::QuizCatalog(const std::string& dataFolder, const std::string& catalogFile) :
+	_dataFolder(normalizePath(dataFolder)), _catalogFile(catalogFile)
+{
+	/** Strip trailing separators such that paths are joined consistently */
+	while ( _dataFolder.size() > 1 && _dataFolder.back() == '/' ) {
+		_dataFolder.pop_back();
+	}
+
+	/** Default Catalog File, it is stored next to the data folder such that saving it does not modify the data folder */
+	if ( _catalogFile.empty() ) {
+		_catalogFile = _dataFolder + ".catalog.xml";
+	}
+
+	/** Load Catalog */
+	load();
+}
+
+void MusicQuiz::util::QuizCatalog::refresh()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	/** Check if data folder exists */
+	if ( !boost::filesystem::is_directory(_dataFolder) ) {
+		throw std::runtime_error("Data folder does not exists.");
+	}
+
+	/** Validate Directories */
+	const std::time_t scanStart = std::time(nullptr);
+	std::vector<std::string> quizFiles;
+	std::map<std::string, DirectoryRecord> directories;
+	validateDirectory(_dataFolder, 0, directories, quizFiles);
+	if ( directories.size() != _directories.size() ) {
+		_dirty = true;
+	}
+	std::sort(quizFiles.begin(), quizFiles.end());
+
+	/** Validate Quizzes */
+	std::vector<QuizRecord> records;
+	records.reserve(quizFiles.size());
+	for ( size_t i = 0; i < quizFiles.size(); ++i ) {
+		size_t idx = 0;
+		const QuizRecord* previous = findRecord(quizFiles[i], idx) ? &_records[idx] : nullptr;
+		try {
+			records.push_back(validateQuiz(quizFiles[i], previous));
+		} catch ( const std::exception& err ) {
+			LOG_WARN("Failed to validate quiz '" << quizFiles[i] << "'. " << err.what());
+		}
+	}
+
+	if ( records.size() != _records.size() ) {
+		_dirty = true;
+	}
+
+	_records = std::move(records);
+	_directories = std::move(directories);
+	indexRecords();
+
+	/** Save Catalog */
+	if ( _dirty ) {
+		_scanTime = scanStart;
+		write();
+	}
+}
+
+void MusicQuiz::util::QuizCatalog::indexRecords()
+{
+	/** Quizzes with identical content share the id, the first one is used and the copies are not listed */
+	_quizIds.clear();
+	_quizIds.reserve(_records.size());
+	for ( size_t i = 0; i < _records.size(); ++i ) {
+		const auto result = _quizIds.emplace(_records[i].contentHash, i);
+		if ( !result.second ) {
+			LOG_WARN("Quiz '" << _records[i].path << "' is identical to '" << _records[result.first->second].path << "' and is not listed.");
+		}
+	}
+}
+
+bool MusicQuiz::util::QuizCatalog::isListed(const size_t idx) const
+{
+	const auto it = _quizIds.find(_records[idx].contentHash);
+	return it != _quizIds.end() && it->second == idx;
+}
+
+void MusicQuiz::util::QuizCatalog::validateDirectory(const std::string& directory, const size_t depth, std::map<std::string, DirectoryRecord>& directories, std::vector<std::string>& quizFiles)
+{
+	boost::system::error_code err;
+	const std::time_t lastWriteTime = boost::filesystem::last_write_time(directory, err);
+	if ( err ) {
+		return;
+	}
+
+	/**
+	 * The listing of a directory only changes if its modification time changes. Directories modified within the
+	 * same second as the last scan are listed again since the change might have happened after the scan.
+	 */
+	DirectoryRecord record;
+	const auto known = _directories.find(directory);
+	if ( known != _directories.end() && known->second.lastWriteTime == lastWriteTime && lastWriteTime < _scanTime ) {
+		record = known->second;
+	} else {
+		record.lastWriteTime = lastWriteTime;
+
+		boost::filesystem::directory_iterator end;
+		for ( boost::filesystem::directory_iterator file(directory, err); !err && file != end; file.increment(err) ) {
+			const std::string fileName = file->path().filename().string();
+			if ( boost::filesystem::is_directory(file->symlink_status()) ) {
+				if ( depth < MAX_DISCOVERY_DEPTH && !isHiddenDirectory(fileName) ) {
+					record.subdirectories.push_back(normalizePath(file->path().string()));
+				}
+			} else if ( isQuizFile(fileName) ) {
+				record.quizFiles.push_back(normalizePath(file->path().string()));
+			}
+		}
+		std::sort(record.subdirectories.begin(), record.subdirectories.end());
+		std::sort(record.quizFiles.begin(), record.quizFiles.end());
+
+		/** Only save the catalog if the listing changed */
+		if ( known == _directories.end() || known->second.subdirectories != record.subdirectories || known->second.quizFiles != record.quizFiles ) {
+			_dirty = true;
+		}
+	}
+
+	/** Add Record */
+	quizFiles.insert(quizFiles.end(), record.quizFiles.begin(), record.quizFiles.end());
+	const std::vector<std::string> subdirectories = record.subdirectories;
+	directories[directory] = std::move(record);
+
+	/** Validate Subdirectories */
+	for ( size_t i = 0; i < subdirectories.size(); ++i ) {
+		validateDirectory(subdirectories[i], depth + 1, directories, quizFiles);
+	}
+}
+
+MusicQuiz::util::QuizCatalog::QuizRecord MusicQuiz::util::QuizCatalog::validateQuiz(const std::string& path, const QuizRecord* previous)
+{
+	/** Check if the file changed */
+	QuizRecord record;
+	record.path = path;
+	record.lastWriteTime = boost::filesystem::last_write_time(path);
+	record.fileSize = boost::filesystem::file_size(path);
+	if ( previous != nullptr && previous->lastWriteTime == record.lastWriteTime && previous->fileSize == record.fileSize && record.lastWriteTime < _scanTime ) {
+		return *previous;
+	}
+	_dirty = true;
+
+	/** Hash the content, the preview is kept if the content is unchanged (e.g. the file was touched or copied) */
+	record.contentHash = common::HashUtil::hashFile(path);
+	if ( previous != nullptr && previous->contentHash == record.contentHash ) {
+		record.previewValid = previous->previewValid;
+		record.previewError = previous->previewError;
+		record.preview = previous->preview;
+		return record;
+	}
+
+	/** The preview is parsed on demand */
+	return record;
+}
+
+MusicQuiz::util::QuizPreview MusicQuiz::util::QuizCatalog::getPreview(const std::string& path)
+{
+	const std::string normalizedPath = normalizePath(path);
+
+	/** Cached Preview */
+	std::string contentHash = "";
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		size_t idx = 0;
+		if ( !findRecord(normalizedPath, idx) ) {
+			throw std::runtime_error("Quiz does not exists.");
+		}
+
+		const QuizRecord& record = _records[idx];
+		if ( record.previewValid ) {
+			return record.preview;
+		} else if ( !record.previewError.empty() ) {
+			throw std::runtime_error(record.previewError);
+		}
+		contentHash = record.contentHash;
+	}
+
+	/** Parse Preview */
+	MusicQuiz::util::QuizPreview preview;
+	std::string previewError = "";
+	try {
+		preview = MusicQuiz::util::QuizLoader::parseQuizPreview(normalizedPath);
+	} catch ( const std::exception& err ) {
+		previewError = err.what();
+	} catch ( ... ) {
+		previewError = "Unknown error.";
+	}
+
+	/** Store Preview, unless the catalog was refreshed with a different version of the file while parsing */
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		size_t idx = 0;
+		if ( findRecord(normalizedPath, idx) && _records[idx].contentHash == contentHash ) {
+			_records[idx].previewValid = previewError.empty();
+			_records[idx].previewError = previewError;
+			_records[idx].preview = preview;
+			_dirty = true;
+		}
+	}
+
+	if ( !previewError.empty() ) {
+		throw std::runtime_error(previewError);
+	}
+
+	return preview;
+}
+
+void MusicQuiz::util::QuizCatalog::load()
+{
+	if ( !boost::filesystem::exists(_catalogFile) ) {
+		return;
+	}
+
+	try {
+		boost::property_tree::ptree tree;
+		boost::property_tree::read_xml(_catalogFile, tree, boost::property_tree::xml_parser::trim_whitespace);
+		const boost::property_tree::ptree& catalogTree = tree.get_child("QuizCatalog");
+
+		/** Version */
+		if ( catalogTree.get<size_t>("Version") != CATALOG_VERSION ) {
+			LOG_INFO("Quiz catalog version changed, rebuilding catalog.");
+			return;
+		}
+		_scanTime = catalogTree.get<std::time_t>("ScanTime");
+
+		/** Directories */
+		std::map<std::string, DirectoryRecord> directories;
+		for ( const auto& directory : catalogTree.get_child("Directories") ) {
+			DirectoryRecord record;
+			record.lastWriteTime = directory.second.get<std::time_t>("<xmlattr>.lastWriteTime");
+			for ( const auto& child : directory.second ) {
+				if ( child.first == "Subdirectory" ) {
+					record.subdirectories.push_back(child.second.data());
+				} else if ( child.first == "QuizFile" ) {
+					record.quizFiles.push_back(child.second.data());
+				}
+			}
+			directories[directory.second.get<std::string>("<xmlattr>.path")] = std::move(record);
+		}
+
+		/** Quizzes */
+		std::vector<QuizRecord> records;
+		for ( const auto& quiz : catalogTree.get_child("Quizzes") ) {
+			QuizRecord record;
+			record.path = quiz.second.get<std::string>("<xmlattr>.path");
+			record.lastWriteTime = quiz.second.get<std::time_t>("<xmlattr>.lastWriteTime");
+			record.fileSize = quiz.second.get<uintmax_t>("<xmlattr>.size");
+			record.contentHash = quiz.second.get<std::string>("<xmlattr>.hash");
+			record.previewError = quiz.second.get<std::string>("Error", "");
+			if ( quiz.second.get_child_optional("Preview") ) {
+				record.preview = readPreview(quiz.second.get_child("Preview"));
+				record.previewValid = true;
+			}
+			records.push_back(std::move(record));
+		}
+		std::sort(records.begin(), records.end(), [](const QuizRecord& a, const QuizRecord& b) { return a.path < b.path; });
+
+		_records = std::move(records);
+		_directories = std::move(directories);
+		indexRecords();
+	} catch ( const std::exception& err ) {
+		LOG_WARN("Failed to load quiz catalog, rebuilding catalog. " << err.what());
+		_scanTime = 0;
+		_records.clear();
+		_directories.clear();
+		_quizIds.clear();
+	}
+}
+
+void MusicQuiz::util::QuizCatalog::save()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	write();
+}
+
+bool MusicQuiz::util::QuizCatalog::isDirty() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _dirty;
+}
+
+void MusicQuiz::util::QuizCatalog::write()
+{
+	boost::property_tree::ptree tree;
+	boost::property_tree::ptree& catalogTree = tree.put("QuizCatalog", "");
+	catalogTree.put("Version", CATALOG_VERSION);
+	catalogTree.put("ScanTime", _scanTime);
+
+	/** Directories */
+	boost::property_tree::ptree& directoriesTree = catalogTree.put("Directories", "");
+	for ( const auto& directory : _directories ) {
+		boost::property_tree::ptree& directoryTree = directoriesTree.add("Directory", "");
+		directoryTree.put("<xmlattr>.path", directory.first);
+		directoryTree.put("<xmlattr>.lastWriteTime", directory.second.lastWriteTime);
+		for ( size_t i = 0; i < directory.second.subdirectories.size(); ++i ) {
+			directoryTree.add("Subdirectory", directory.second.subdirectories[i]);
+		}
+		for ( size_t i = 0; i < directory.second.quizFiles.size(); ++i ) {
+			directoryTree.add("QuizFile", directory.second.quizFiles[i]);
+		}
+	}
+
+	/** Quizzes */
+	boost::property_tree::ptree& quizzesTree = catalogTree.put("Quizzes", "");
+	for ( size_t i = 0; i < _records.size(); ++i ) {
+		boost::property_tree::ptree& quizTree = quizzesTree.add("Quiz", "");
+		quizTree.put("<xmlattr>.path", _records[i].path);
+		quizTree.put("<xmlattr>.lastWriteTime", _records[i].lastWriteTime);
+		quizTree.put("<xmlattr>.size", _records[i].fileSize);
+		quizTree.put("<xmlattr>.hash", _records[i].contentHash);
+		if ( _records[i].previewValid ) {
+			writePreview(quizTree.put("Preview", ""), _records[i].preview);
+		} else if ( !_records[i].previewError.empty() ) {
+			quizTree.put("Error", _records[i].previewError);
+		}
+	}
+
+	/** Write to a temporary file and replace the catalog such that it is never left half written */
+	try {
+		const std::string tmpFile = _catalogFile + ".tmp";
+		boost::property_tree::write_xml(tmpFile, tree);
+		boost::filesystem::rename(tmpFile, _catalogFile);
+		_dirty = false;
+	} catch ( const std::exception& err ) {
+		LOG_WARN("Failed to save quiz catalog. " << err.what());
+	}
+}
+
+size_t MusicQuiz::util::QuizCatalog::size() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _records.size();
+}
+
+std::vector<std::string> MusicQuiz::util::QuizCatalog::getQuizPaths() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	std::vector<std::string> paths;
+	paths.reserve(_records.size());
+	for ( size_t i = 0; i < _records.size(); ++i ) {
+		if ( isListed(i) ) {
+			paths.push_back(_records[i].path);
+		}
+	}
+	return paths;
+}
+
+std::map<std::string, std::string> MusicQuiz::util::QuizCatalog::getQuizIdsByPath() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	std::map<std::string, std::string> quizIds;
+	for ( size_t i = 0; i < _records.size(); ++i ) {
+		if ( isListed(i) ) {
+			quizIds.emplace_hint(quizIds.end(), _records[i].path, _records[i].contentHash);
+		}
+	}
+	return quizIds;
+}
+
+std::vector<std::string> MusicQuiz::util::QuizCatalog::getDirectories() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	std::vector<std::string> directories;
+	directories.reserve(_directories.size());
+	for ( const auto& directory : _directories ) {
+		directories.push_back(directory.first);
+	}
+	return directories;
+}
+
+MusicQuiz::util::QuizCatalog::QuizRecord MusicQuiz::util::QuizCatalog::getRecord(const size_t idx) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	if ( idx >= _records.size() ) {
+		throw std::runtime_error("Index out of range.");
+	}
+	return _records[idx];
+}
+
+bool MusicQuiz::util::QuizCatalog::findQuiz(const std::string& path, size_t& idx) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return findRecord(normalizePath(path), idx);
+}
+
+bool MusicQuiz::util::QuizCatalog::findQuiz(const std::string& path, QuizRecord& record) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	size_t idx = 0;
+	if ( !findRecord(normalizePath(path), idx) ) {
+		return false;
+	}
+
+	record = _records[idx];
+	return true;
+}
+
+bool MusicQuiz::util::QuizCatalog::findQuizById(const std::string& quizId, QuizRecord& record) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	const auto it = _quizIds.find(quizId);
+	if ( it == _quizIds.end() ) {
+		return false;
+	}
+
+	record = _records[it->second];
+	return true;
+}
+
+bool MusicQuiz::util::QuizCatalog::findRecord(const std::string& path, size_t& idx) const
+{
+	const auto it = std::lower_bound(_records.begin(), _records.end(), path,
+		[](const QuizRecord& record, const std::string& value) { return record.path < value; });
+	if ( it == _records.end() || it->path != path ) {
+		return false;
+	}
+
+	idx = static_cast<size_t>(it - _records.begin());
+	return true;
+}
+
+std::string MusicQuiz::util::QuizCatalog::normalizePath(const std::string& path)
+{
+	std::string normalizedPath = path;
+	std::replace(normalizedPath.begin(), normalizedPath.end(), '\\', '/');
+	return normalizedPath;
+}
\ No newline at end of file
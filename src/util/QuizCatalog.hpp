@@ -0,0 +1,253 @@
+#pragma once
+
+#include <map>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <cstdint>
+
+#include "util/QuizPreview.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Persistent index of the quizzes stored in the data folder.
+		 *
+		 * Quiz files are discovered in the data folder and in the quiz folders directly below it ('./data/<Quiz>/').
+		 * Deeper folders such as the media folders and hidden folders are never listed, such that the discovery cost is
+		 * proportional to the number of quizzes and not to the number of media files.
+		 *
+		 * The catalog is stored next to the data folder and is validated incrementally using the modification times of
+		 * the directories and quiz files. Only directories that changed are listed again and only quiz files that
+		 * changed are hashed again. Previews are parsed on demand such that they can be loaded in parallel.
+		 *
+		 * Quizzes are identified by the hash of their content, such that the id of a quiz does not depend on its position
+		 * in the data folder and stays valid while quizzes are added or removed. Quizzes with identical content share the
+		 * id, only the first of them is listed.
+		 *
+		 * All public functions are thread safe.
+		 */
+		class QuizCatalog
+		{
+		public:
+			struct QuizRecord
+			{
+				std::string path = "";
+				std::time_t lastWriteTime = 0;
+				uintmax_t fileSize = 0;
+				std::string contentHash = "";
+
+				bool previewValid = false;
+				std::string previewError = "";
+				MusicQuiz::util::QuizPreview preview;
+			};
+
+			/**
+			 * @brief Shared Pointer
+			 */
+			typedef std::shared_ptr< QuizCatalog > Ptr;
+			typedef std::shared_ptr< const QuizCatalog > CPtr;
+
+			/**
+			 * @brief Constructor. Loads the catalog file if it exists.
+			 *
+			 * @param[in] dataFolder The folder containing the quizzes.
+			 * @param[in] catalogFile The catalog file, defaults to '<dataFolder>.catalog.xml' next to the data folder.
+			 */
+			explicit QuizCatalog(const std::string& dataFolder = "./data/", const std::string& catalogFile = "");
+
+			/**
+			 * @brief Default Destructor
+			 */
+			virtual ~QuizCatalog() = default;
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			QuizCatalog(const QuizCatalog&) = delete;
+			QuizCatalog& operator=(const QuizCatalog&) = delete;
+
+			/**
+			 * @brief Validates the catalog against the data folder and saves it if anything changed.
+			 */
+			void refresh();
+
+			/**
+			 * @brief Saves the catalog file.
+			 */
+			void save();
+
+			/**
+			 * @brief Checks if the catalog changed since it was saved.
+			 *
+			 * @return True if the catalog should be saved.
+			 */
+			bool isDirty() const;
+
+			/**
+			 * @brief Returns the number of quizzes in the catalog.
+			 *
+			 * @return The number of quizzes.
+			 */
+			size_t size() const;
+
+			/**
+			 * @brief Returns the list of quiz files sorted by path. Quizzes identical to a previous quiz are not listed.
+			 *
+			 * @return The list of quiz files.
+			 */
+			std::vector<std::string> getQuizPaths() const;
+
+			/**
+			 * @brief Returns the ids of the listed quizzes by path.
+			 *
+			 * @return The quiz ids by path.
+			 */
+			std::map<std::string, std::string> getQuizIdsByPath() const;
+
+			/**
+			 * @brief Returns the directories that are listed to discover the quizzes.
+			 *
+			 * @return The directories.
+			 */
+			std::vector<std::string> getDirectories() const;
+
+			/**
+			 * @brief Returns a quiz record.
+			 *
+			 * @param[in] idx The index of the quiz.
+			 *
+			 * @return A copy of the quiz record.
+			 */
+			QuizRecord getRecord(size_t idx) const;
+
+			/**
+			 * @brief Finds a quiz by its id.
+			 *
+			 * @param[in] quizId The quiz id.
+			 * @param[out] record A copy of the quiz record.
+			 *
+			 * @return True if the quiz is in the catalog.
+			 */
+			bool findQuizById(const std::string& quizId, QuizRecord& record) const;
+
+			/**
+			 * @brief Returns the preview of a quiz. The quiz is parsed if the preview is not cached, the catalog is not
+			 *        locked while parsing such that multiple previews can be parsed in parallel.
+			 *
+			 * @param[in] path The quiz file.
+			 *
+			 * @return The quiz preview.
+			 */
+			MusicQuiz::util::QuizPreview getPreview(const std::string& path);
+
+			/**
+			 * @brief Finds the index of a quiz file.
+			 *
+			 * @param[in] path The quiz file.
+			 * @param[out] idx The index of the quiz.
+			 *
+			 * @return True if the quiz is in the catalog.
+			 */
+			bool findQuiz(const std::string& path, size_t& idx) const;
+
+			/**
+			 * @brief Finds a quiz by its path.
+			 *
+			 * @param[in] path The quiz file.
+			 * @param[out] record A copy of the quiz record.
+			 *
+			 * @return True if the quiz is in the catalog.
+			 */
+			bool findQuiz(const std::string& path, QuizRecord& record) const;
+
+			/**
+			 * @brief Normalizes a path such that it uses '/' as separator.
+			 *
+			 * @param[in] path The path.
+			 *
+			 * @return The normalized path.
+			 */
+			static std::string normalizePath(const std::string& path);
+
+		protected:
+			struct DirectoryRecord
+			{
+				std::time_t lastWriteTime = 0;
+				std::vector<std::string> subdirectories;
+				std::vector<std::string> quizFiles;
+			};
+
+			/**
+			 * @brief Loads the catalog file.
+			 */
+			void load();
+
+			/**
+			 * @brief Writes the catalog file. The mutex must be locked by the caller.
+			 */
+			void write();
+
+			/**
+			 * @brief Finds the index of a quiz file. The mutex must be locked by the caller.
+			 *
+			 * @param[in] path The normalized quiz file.
+			 * @param[out] idx The index of the quiz.
+			 *
+			 * @return True if the quiz is in the catalog.
+			 */
+			bool findRecord(const std::string& path, size_t& idx) const;
+
+			/**
+			 * @brief Rebuilds the quiz id map. The mutex must be locked by the caller.
+			 */
+			void indexRecords();
+
+			/**
+			 * @brief Checks if a quiz is listed, a quiz with the same content as a previous quiz shares its id and is
+			 *        not listed. The mutex must be locked by the caller.
+			 *
+			 * @param[in] idx The index of the quiz.
+			 *
+			 * @return True if the quiz is listed.
+			 */
+			bool isListed(size_t idx) const;
+
+			/**
+			 * @brief Validates a directory and its subdirectories up to the maximum discovery depth.
+			 *
+			 * @param[in] directory The directory.
+			 * @param[in] depth The depth of the directory below the data folder.
+			 * @param[in] directories The validated directories.
+			 * @param[out] quizFiles The quiz files found.
+			 */
+			void validateDirectory(const std::string& directory, size_t depth, std::map<std::string, DirectoryRecord>& directories, std::vector<std::string>& quizFiles);
+
+			/**
+			 * @brief Validates a quiz file, it is hashed again if it changed and the preview is dropped if the content changed.
+			 *
+			 * @param[in] path The quiz file.
+			 * @param[in] previous The previous record if any.
+			 *
+			 * @return The quiz record.
+			 */
+			QuizRecord validateQuiz(const std::string& path, const QuizRecord* previous);
+
+			/** Variables */
+			mutable std::mutex _mutex;
+
+			bool _dirty = false;
+			std::time_t _scanTime = 0;
+			std::string _dataFolder = "";
+			std::string _catalogFile = "";
+
+			std::vector<QuizRecord> _records;
+			std::unordered_map<std::string, size_t> _quizIds;
+			std::map<std::string, DirectoryRecord> _directories;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "QuizCatalogWatcher.hpp"
+
+#include <set>
+#include <stdexcept>
+
+#include <QStringList>
+
+#include "common/Log.hpp"
+#include "util/FunctionTask.hpp"
+
+
+namespace {
+	/** Time to wait for further changes before the catalog is refreshed */
+	constexpr int REFRESH_DELAY_MS = 250;
+}
+
+
+MusicQuiz::util::QuizCatalogWatcher::QuizCatalogWatcher(const MusicQuiz::util::QuizCatalog::Ptr& catalog, QObject* parent) :
+	QObject(parent), _catalog(catalog)
+{
+	/** Sanity Check */
+	if ( _catalog == nullptr ) {
+		throw std::runtime_error("Can not watch quiz catalog. The catalog is nullptr.");
+	}
+
+	/** Refresh Timer */
+	_refreshTimer.setSingleShot(true);
+	_refreshTimer.setInterval(REFRESH_DELAY_MS);
+	connect(&_refreshTimer, SIGNAL(timeout()), this, SLOT(startRefresh()));
+
+	/** Watcher */
+	_refreshPool.setMaxThreadCount(1);
+	connect(&_watcher, SIGNAL(directoryChanged(const QString&)), this, SLOT(scheduleRefresh()));
+	connect(&_watcher, SIGNAL(fileChanged(const QString&)), this, SLOT(scheduleRefresh()));
+
+	/** Watch the current state of the catalog */
+	_quizIds = _catalog->getQuizIdsByPath();
+	updateWatchedPaths();
+}
+
+MusicQuiz::util::QuizCatalogWatcher::~QuizCatalogWatcher()
+{
+	/** Wait for a running refresh, its queued result is discarded together with the watcher */
+	_refreshPool.waitForDone();
+}
+
+void MusicQuiz::util::QuizCatalogWatcher::refresh()
+{
+	_refreshTimer.stop();
+	startRefresh();
+}
+
+void MusicQuiz::util::QuizCatalogWatcher::scheduleRefresh()
+{
+	_refreshTimer.start();
+}
+
+void MusicQuiz::util::QuizCatalogWatcher::startRefresh()
+{
+	/** Only a single refresh runs at a time, changes during a refresh are handled when it is done */
+	if ( _refreshRunning ) {
+		_refreshPending = true;
+		return;
+	}
+	_refreshRunning = true;
+
+	const MusicQuiz::util::QuizCatalog::Ptr catalog = _catalog;
+	_refreshPool.start(new MusicQuiz::util::FunctionTask([this, catalog]() {
+		try {
+			catalog->refresh();
+		} catch ( const std::exception& err ) {
+			LOG_WARN("Failed to refresh quiz catalog. " << err.what());
+		} catch ( ... ) {
+			LOG_WARN("Failed to refresh quiz catalog.");
+		}
+
+		QMetaObject::invokeMethod(this, [this]() { refreshDone(); }, Qt::QueuedConnection);
+	}));
+}
+
+void MusicQuiz::util::QuizCatalogWatcher::refreshDone()
+{
+	_refreshRunning = false;
+
+	/** Emit Changes */
+	const std::map<std::string, std::string> quizIds = _catalog->getQuizIdsByPath();
+	for ( const auto& quiz : _quizIds ) {
+		if ( quizIds.find(quiz.first) == quizIds.end() ) {
+			emit quizRemoved(QString::fromStdString(quiz.first));
+		}
+	}
+
+	for ( const auto& quiz : quizIds ) {
+		const auto known = _quizIds.find(quiz.first);
+		if ( known == _quizIds.end() ) {
+			emit quizAdded(QString::fromStdString(quiz.first));
+		} else if ( known->second != quiz.second ) {
+			emit quizModified(QString::fromStdString(quiz.first));
+		}
+	}
+	_quizIds = quizIds;
+
+	/** Watch new directories and quiz files */
+	updateWatchedPaths();
+
+	/** Pending Refresh */
+	if ( _refreshPending ) {
+		_refreshPending = false;
+		startRefresh();
+	}
+}
+
+void MusicQuiz::util::QuizCatalogWatcher::updateWatchedPaths()
+{
+	/** Paths to Watch */
+	std::set<QString> paths;
+	const std::vector<std::string> directories = _catalog->getDirectories();
+	for ( size_t i = 0; i < directories.size(); ++i ) {
+		paths.insert(QString::fromStdString(directories[i]));
+	}
+
+	for ( const auto& quiz : _quizIds ) {
+		paths.insert(QString::fromStdString(quiz.first));
+	}
+
+	/** Remove paths that are no longer part of the catalog */
+	QStringList removedPaths;
+	const QStringList watchedPaths = _watcher.directories() + _watcher.files();
+	for ( const QString& path : watchedPaths ) {
+		if ( paths.erase(path) == 0 ) {
+			removedPaths.append(path);
+		}
+	}
+
+	if ( !removedPaths.isEmpty() ) {
+		_watcher.removePaths(removedPaths);
+	}
+
+	/** Add new paths, files that are replaced by a rename are removed by the watcher and added again here */
+	QStringList addedPaths;
+	for ( const QString& path : paths ) {
+		addedPaths.append(path);
+	}
+
+	if ( !addedPaths.isEmpty() ) {
+		_watcher.addPaths(addedPaths);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <memory>
+
+#include <QTimer>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <QFileSystemWatcher>
+
+#include "util/QuizCatalog.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Keeps a quiz catalog up to date while it is in use.
+		 *
+		 * The discovered directories and quiz files are watched using the file system notifications of the platform
+		 * (inotify on Linux). Changes are collected for a short while and the catalog is then validated on a worker
+		 * thread, only the changed directories and files are listed and hashed again. The differences are emitted as
+		 * incremental add, modify and remove signals on the thread of the watcher.
+		 */
+		class QuizCatalogWatcher : public QObject
+		{
+			Q_OBJECT
+		public:
+			/**
+			 * @brief Constructor
+			 *
+			 * @param[in] catalog The quiz catalog to keep up to date.
+			 * @param[in] parent The parent object.
+			 */
+			explicit QuizCatalogWatcher(const std::shared_ptr< MusicQuiz::util::QuizCatalog >& catalog, QObject* parent = nullptr);
+
+			/**
+			 * @brief Destructor, waits for a running refresh to finish.
+			 */
+			virtual ~QuizCatalogWatcher();
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			QuizCatalogWatcher(const QuizCatalogWatcher&) = delete;
+			QuizCatalogWatcher& operator=(const QuizCatalogWatcher&) = delete;
+
+		public slots:
+			/**
+			 * @brief Refreshes the catalog on the worker thread without delay, e.g. to validate a cached catalog
+			 *        that is already shown. The differences are emitted as for a change.
+			 */
+			void refresh();
+
+		signals:
+			void quizAdded(const QString& quizFile);
+			void quizModified(const QString& quizFile);
+			void quizRemoved(const QString& quizFile);
+
+		private slots:
+			/**
+			 * @brief Schedules a refresh of the catalog, the refresh is delayed such that bursts of changes are merged.
+			 */
+			void scheduleRefresh();
+
+			/**
+			 * @brief Starts the refresh of the catalog on the worker thread.
+			 */
+			void startRefresh();
+
+		private:
+			/**
+			 * @brief Emits the changes of the catalog and starts a pending refresh.
+			 */
+			void refreshDone();
+
+			/**
+			 * @brief Watches the directories and quiz files of the catalog.
+			 */
+			void updateWatchedPaths();
+
+			/** Variables */
+			bool _refreshRunning = false;
+			bool _refreshPending = false;
+
+			QTimer _refreshTimer;
+			QThreadPool _refreshPool;
+			QFileSystemWatcher _watcher;
+
+			std::shared_ptr< MusicQuiz::util::QuizCatalog > _catalog = nullptr;
+			std::map<std::string, std::string> _quizIds;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "QuizDocument.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/optional.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+
+#include "common/Log.hpp"
+
+
+namespace {
+	template <typename T>
+	void readField(const boost::property_tree::ptree& tree, const std::string& field, T& value, std::vector<std::string>& missingFields)
+	{
+		const boost::optional<T> optionalValue = tree.get_optional<T>(field);
+		if ( optionalValue ) {
+			value = *optionalValue;
+		} else {
+			missingFields.push_back(field);
+		}
+	}
+}
+
+
+bool MusicQuiz::util::QuizDocument::Entry::hasField(const std::string_view field) const
+{
+	return std::find(missingFields.begin(), missingFields.end(), field) == missingFields.end();
+}
+
+MusicQuiz::util::QuizDocument::CPtr MusicQuiz::util::QuizDocument::load(const std::string& quizFile)
+{
+	/** Sanity Check */
+	if ( !boost::filesystem::exists(quizFile) ) {
+		throw std::runtime_error("Quiz file does not exists.");
+	}
+
+	/** File Info (read before parsing such that a concurrent change invalidates the document) */
+	QuizDocument::Ptr document = std::make_shared<QuizDocument>();
+	document->path = quizFile;
+	document->lastWriteTime = boost::filesystem::last_write_time(quizFile);
+	document->fileSize = boost::filesystem::file_size(quizFile);
+
+	/** Parse */
+	boost::property_tree::ptree tree;
+	boost::property_tree::read_xml(quizFile, tree, boost::property_tree::xml_parser::trim_whitespace);
+	const boost::property_tree::ptree& sub_tree = tree.get_child("MusicQuiz");
+
+	/** Header */
+	readField(sub_tree, "QuizName", document->quizName, document->missingFields);
+	readField(sub_tree, "QuizAuthor", document->quizAuthor, document->missingFields);
+	readField(sub_tree, "QuizDescription", document->quizDescription, document->missingFields);
+	document->guessTheCategory = sub_tree.get("QuizGuessTheCategory.<xmlattr>.enabled", false);
+
+	/** Categories & Row Categories */
+	for ( const auto& ctrl : sub_tree ) {
+		if ( ctrl.first == "QuizCategories" ) { // Load Categories
+			for ( const auto& sub_ctrl : ctrl.second ) {
+				if ( sub_ctrl.first != "Category" ) {
+					continue;
+				}
+
+				/** Category Name, the remaining categories are skipped if it is missing */
+				const boost::optional<std::string> categoryName = sub_ctrl.second.get_optional<std::string>("<xmlattr>.name");
+				if ( !categoryName ) {
+					LOG_ERROR("Failed to load category. Category without a name in '" << quizFile << "'.");
+					document->missingFields.push_back("QuizCategories.Category.<xmlattr>.name");
+					break;
+				}
+
+				Category category;
+				category.name = *categoryName;
+
+				/** Category Entries */
+				for ( const auto& it : sub_ctrl.second ) {
+					if ( it.first != "QuizEntry" ) {
+						continue;
+					}
+
+					Entry entry;
+					readField(it.second, "<xmlattr>.name", entry.name, entry.missingFields);
+					readField(it.second, "<xmlattr>.type", entry.type, entry.missingFields);
+					readField(it.second, "Answer", entry.answer, entry.missingFields);
+					readField(it.second, "Points", entry.points, entry.missingFields);
+					readField(it.second, "StartTime", entry.startTime, entry.missingFields);
+					readField(it.second, "VideoSongStartTime", entry.videoSongStartTime, entry.missingFields);
+					readField(it.second, "AnswerStartTime", entry.answerStartTime, entry.missingFields);
+					readField(it.second, "Media.SongFile", entry.songFile, entry.missingFields);
+					readField(it.second, "Media.VideoFile", entry.videoFile, entry.missingFields);
+					entry.clipOffset = it.second.get<size_t>("Media.<xmlattr>.clipOffset", 0);
+					entry.songSource = it.second.get<std::string>("Media.<xmlattr>.source", "");
+					entry.videoSource = it.second.get<std::string>("Media.<xmlattr>.videoSource", "");
+					category.entries.push_back(std::move(entry));
+				}
+
+				document->categories.push_back(std::move(category));
+			}
+		} else if ( ctrl.first == "QuizRowCategories" ) { // Load Row Categories
+			for ( const auto& sub_ctrl : ctrl.second ) {
+				if ( sub_ctrl.first == "RowCategory" ) {
+					document->rowCategories.push_back(sub_ctrl.second.data());
+				}
+			}
+		}
+	}
+
+	return document;
+}
\ No newline at end of file
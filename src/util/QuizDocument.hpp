@@ -0,0 +1,84 @@
+#pragma once
+
+#include <ctime>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <string_view>
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief The content of a quiz file produced by a single parse.
+		 *
+		 * Fields that are missing in the file are left at their default value and listed in the missing fields such
+		 * that each consumer can decide which fields it requires.
+		 */
+		struct QuizDocument
+		{
+			struct Entry
+			{
+				std::string name = "";
+				std::string answer = "";
+				std::string type = "";
+				size_t points = 0;
+				size_t startTime = 0;
+				size_t videoSongStartTime = 0;
+				size_t answerStartTime = 0;
+				std::string songFile = "";
+				std::string videoFile = "";
+				std::vector<std::string> missingFields;
+
+				/** Clipped media, the offset of the clip in its source files. The sources are empty if the media is not a clip */
+				size_t clipOffset = 0;
+				std::string songSource = "";
+				std::string videoSource = "";
+
+				/**
+				 * @brief Checks if a field was present in the quiz file.
+				 *
+				 * @param[in] field The field name, e.g. 'Points' or 'Media.SongFile'.
+				 *
+				 * @return True if the field was present.
+				 */
+				bool hasField(std::string_view field) const;
+			};
+
+			struct Category
+			{
+				std::string name = "";
+				std::vector<Entry> entries;
+			};
+
+			/**
+			 * @brief Shared Pointer
+			 */
+			typedef std::shared_ptr< QuizDocument > Ptr;
+			typedef std::shared_ptr< const QuizDocument > CPtr;
+
+			std::string path = "";
+			std::time_t lastWriteTime = 0;
+			uintmax_t fileSize = 0;
+
+			std::string quizName = "";
+			std::string quizAuthor = "";
+			std::string quizDescription = "";
+			bool guessTheCategory = false;
+			std::vector<std::string> missingFields;
+
+			std::vector<Category> categories;
+			std::vector<std::string> rowCategories;
+
+			/**
+			 * @brief Parses a quiz file.
+			 *
+			 * @param[in] quizFile The quiz file.
+			 *
+			 * @return The quiz document.
+			 */
+			static CPtr load(const std::string& quizFile);
+		};
+	}
+}
\ No newline at end of file
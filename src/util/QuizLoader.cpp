@@ -1,257 +1,347 @@
 #include "QuizLoader.hpp"
 
+#include <list>
+#include <cmath>
+#include <mutex>
+#include <random>
 #include <stdexcept>
 #include <algorithm>
 
-#include <boost/property_tree/ptree.hpp>
-#include <boost/property_tree/xml_parser.hpp>
-
 #include "common/Log.hpp"
+#include "util/QuizBinary.hpp"
+#include "util/QuizPack.hpp"
+#include "util/QuizCatalog.hpp"
+#include "util/MediaValidator.hpp"
+#include "util/MediaStagingCache.hpp"
+#include "util/QuizPreviewParser.hpp"
+
+
+namespace {
+	/** Number of parsed quiz documents to keep */
+	constexpr size_t DOCUMENT_CACHE_SIZE = 8;
+
+	std::mutex documentCacheMutex;
+	std::list<MusicQuiz::util::QuizDocument::CPtr> documentCache;
+
+	size_t getDailyCount(const size_t numberOfEntries, const size_t percentage)
+	{
+		/** Ensure that there is atleast one entry if the setting is enabled */
+		const size_t count = static_cast<size_t>(std::floor(static_cast<double>(numberOfEntries * percentage) / 100.0));
+		return std::max<size_t>(count, 1);
+	}
 
-#include "gui_tools/widgets/QuizEntry.hpp"
+	void selectDailyEntries(MusicQuiz::util::QuizModel& model, const MusicQuiz::QuizSettings& settings)
+	{
+		/** Entries */
+		std::vector<MusicQuiz::util::QuizModel::Entry*> entries;
+		for ( MusicQuiz::util::QuizModel::Category& category : model.categories ) {
+			for ( MusicQuiz::util::QuizModel::Entry& entry : category.entries ) {
+				entries.push_back(&entry);
+			}
+		}
 
+		/** Shuffle the entries, the first entries are daily double and the following are daily triple */
+		std::vector<MusicQuiz::util::QuizModel::Entry*> shuffledEntries = entries;
+		std::shuffle(shuffledEntries.begin(), shuffledEntries.end(), std::mt19937(std::random_device{}()));
 
-std::vector<std::string> MusicQuiz::util::QuizLoader::getListOfQuizzes()
-{
-	/** Check if data folder exists */
-	const boost::filesystem::path dataFolder = "./data/";
-	if ( !boost::filesystem::is_directory(dataFolder) ) {
-		throw std::runtime_error("Data folder does not exists.");
+		size_t idx = 0;
+		if ( settings.dailyDouble ) {
+			const size_t count = getDailyCount(entries.size(), settings.dailyDoublePercentage);
+			for ( size_t i = 0; i < count && idx < shuffledEntries.size(); ++i, ++idx ) {
+				shuffledEntries[idx]->doublePoints = true;
+			}
+		}
+
+		if ( settings.dailyTriple ) {
+			const size_t count = getDailyCount(entries.size(), settings.dailyTriplePercentage);
+			for ( size_t i = 0; i < count && idx < shuffledEntries.size(); ++i, ++idx ) {
+				shuffledEntries[idx]->triplePoints = true;
+			}
+		}
+	}
+
+	/**
+	 * @brief Fields of a quiz entry, viewed from a quiz document or a compiled quiz.
+	 */
+	struct EntryFields
+	{
+		std::string_view answer;
+		std::string_view type;
+		std::string_view songFile;
+		std::string_view videoFile;
+		size_t points = 0;
+		size_t startTime = 0;
+		size_t videoSongStartTime = 0;
+		size_t answerStartTime = 0;
+	};
+
+	template <typename HasField>
+	void requireFields(const HasField& hasField, const std::initializer_list<const char*> fields)
+	{
+		for ( const char* field : fields ) {
+			if ( !hasField(field) ) {
+				throw std::runtime_error("No such node (" + std::string(field) + ")");
+			}
+		}
 	}
 
-	/** Find Quizzes */
-	std::vector<std::string> quizList;
-	boost::filesystem::recursive_directory_iterator end;
+	template <typename HasField>
+	void addEntry(MusicQuiz::util::QuizModel& model, MusicQuiz::util::QuizModel::Category& modelCategory, const std::string& fullPath,
+		const EntryFields& entry, const HasField& hasField)
+	{
+		/** Settings */
+		requireFields(hasField, { "Answer", "Points", "AnswerStartTime", "<xmlattr>.type" });
+		MusicQuiz::util::QuizModel::Entry modelEntry;
+		modelEntry.answer = model.strings->intern(entry.answer);
+		modelEntry.points = entry.points;
+		modelEntry.answerStartTime = entry.answerStartTime;
+
+		/** Media Type */
+		if ( entry.type == "song" ) { // Song
+			requireFields(hasField, { "Media.SongFile", "StartTime" });
+			modelEntry.type = MusicQuiz::util::QuizModel::EntryType::SONG;
+			modelEntry.songFile = model.strings->internPath(fullPath, entry.songFile);
+			modelEntry.songStartTime = entry.startTime;
+		} else if ( entry.type == "video" ) { // Video
+			requireFields(hasField, { "Media.SongFile", "Media.VideoFile", "StartTime", "VideoSongStartTime" });
+			modelEntry.type = MusicQuiz::util::QuizModel::EntryType::VIDEO;
+			modelEntry.songFile = model.strings->internPath(fullPath, entry.songFile);
+			modelEntry.videoFile = model.strings->internPath(fullPath, entry.videoFile);
+			modelEntry.songStartTime = entry.videoSongStartTime;
+			modelEntry.videoStartTime = entry.startTime;
+		} else {
+			return;
+		}
+
+		modelCategory.entries.push_back(std::move(modelEntry));
+	}
 
-	for ( boost::filesystem::recursive_directory_iterator file(dataFolder); file != end; ++file ) {
-		const std::string fileStr = boost::filesystem::path(*file).string();
+	void loadCategories(MusicQuiz::util::QuizModel& model, const MusicQuiz::util::QuizDocument& document, const std::string& fullPath)
+	{
+		for ( const MusicQuiz::util::QuizDocument::Category& category : document.categories ) {
+			MusicQuiz::util::QuizModel::Category modelCategory;
+			modelCategory.name = category.name;
+			modelCategory.entries.reserve(category.entries.size());
+
+			/** Category Entries */
+			for ( const MusicQuiz::util::QuizDocument::Entry& entry : category.entries ) {
+				const EntryFields fields = { entry.answer, entry.type, entry.songFile, entry.videoFile, entry.points, entry.startTime,
+					entry.videoSongStartTime, entry.answerStartTime };
+				addEntry(model, modelCategory, fullPath, fields, [&entry](const char* field) { return entry.hasField(field); });
+			}
 
-		/** Skip non quiz files */
-		if ( fileStr.find(".quiz.xml") == std::string::npos ) {
-			continue;
+			model.categories.push_back(std::move(modelCategory));
 		}
+	}
+
+	void loadCategories(MusicQuiz::util::QuizModel& model, const MusicQuiz::util::QuizBinary& binary, const std::string& fullPath)
+	{
+		/** The strings are viewed in the mapped file and only the interned copies are kept */
+		const MusicQuiz::util::QuizBinary::Header& header = binary.getHeader();
+		for ( size_t i = 0; i < header.categoryCount; ++i ) {
+			const MusicQuiz::util::QuizBinary::CategoryRecord& category = binary.getCategory(i);
+			MusicQuiz::util::QuizModel::Category modelCategory;
+			modelCategory.name = std::string(binary.getString(category.name));
+			modelCategory.entries.reserve(category.entryCount);
+
+			/** Category Entries */
+			for ( size_t j = 0; j < category.entryCount; ++j ) {
+				const MusicQuiz::util::QuizBinary::EntryRecord& entry = binary.getEntry(category.firstEntry + j);
+				const EntryFields fields = { binary.getString(entry.answer), binary.getString(entry.type), binary.getString(entry.songFile),
+					binary.getString(entry.videoFile), static_cast<size_t>(entry.points), static_cast<size_t>(entry.startTime),
+					static_cast<size_t>(entry.videoSongStartTime), static_cast<size_t>(entry.answerStartTime) };
+				addEntry(model, modelCategory, fullPath, fields, [&entry](const char* field) { return MusicQuiz::util::QuizBinary::hasField(entry, field); });
+			}
 
-		/** Push back quiz */
-		quizList.push_back(fileStr);
+			model.categories.push_back(std::move(modelCategory));
+		}
 	}
+}
 
-	return quizList;
+
+MusicQuiz::util::QuizCatalog::Ptr MusicQuiz::util::QuizLoader::getCatalog()
+{
+	static const MusicQuiz::util::QuizCatalog::Ptr catalog = std::make_shared<MusicQuiz::util::QuizCatalog>("./data/");
+	return catalog;
 }
 
-MusicQuiz::util::QuizLoader::QuizPreview MusicQuiz::util::QuizLoader::getQuizPreview(size_t idx)
+std::vector<std::string> MusicQuiz::util::QuizLoader::getListOfQuizzes()
 {
-	/** Get List of Quizzes */
-	const std::vector<std::string> quizList = getListOfQuizzes();
-	if ( quizList.empty() ) {
-		throw std::runtime_error("No quizzes found in the data folder.");
-	}
+	/** Validate Catalog */
+	const MusicQuiz::util::QuizCatalog::Ptr catalog = getCatalog();
+	catalog->refresh();
 
-	/** Sanity Check */
-	if ( idx >= quizList.size() ) {
-		throw std::runtime_error("Index out of range.");
-	}
+	return catalog->getQuizPaths();
+}
 
-	if ( !boost::filesystem::exists(quizList[idx]) ) {
-		throw std::runtime_error("Quiz file does not exists.");
-	}
+std::string MusicQuiz::util::QuizLoader::getQuizId(const std::string& quizFile)
+{
+	/** Find Quiz */
+	const MusicQuiz::util::QuizCatalog::Ptr catalog = getCatalog();
+	size_t idx = 0;
+	if ( !catalog->findQuiz(quizFile, idx) ) {
+		/** The quiz might have been added after the catalog was refreshed */
+		catalog->refresh();
+		if ( catalog->size() == 0 ) {
+			throw std::runtime_error("No quizzes found in the data folder.");
+		}
 
-	/** Load preview */
-	QuizLoader::QuizPreview quizPreview;
-	boost::property_tree::ptree tree;
-	boost::property_tree::read_xml(quizList[idx], tree, boost::property_tree::xml_parser::trim_whitespace);
-	boost::property_tree::ptree sub_tree = tree.get_child("MusicQuiz");
-
-	/** Name */
-	quizPreview.quizName = sub_tree.get<std::string>("QuizName");
-
-	/** Author */
-	quizPreview.quizAuthor = sub_tree.get<std::string>("QuizAuthor");
-
-	/** Description */
-	quizPreview.quizDescription = sub_tree.get<std::string>("QuizDescription");
-
-	/** Guess the Category */
-	quizPreview.guessTheCategory = sub_tree.get("QuizGuessTheCategory.<xmlattr>.enabled", false);
-
-	/** Categories & Row Categories */
-	boost::property_tree::ptree::const_iterator ctrl = sub_tree.begin();
-	for ( ; ctrl != sub_tree.end(); ++ctrl ) {
-		if ( ctrl->first == "QuizCategories" ) { // Load Categories
-			boost::property_tree::ptree categoriesTree = ctrl->second;
-			boost::property_tree::ptree::const_iterator sub_ctrl = categoriesTree.begin();
-			for ( ; sub_ctrl != categoriesTree.end(); ++sub_ctrl ) {
-				if ( sub_ctrl->first == "Category" ) {
-					quizPreview.categories.push_back(sub_ctrl->second.get<std::string>("<xmlattr>.name"));
-
-					if ( !quizPreview.includeSongs || !quizPreview.includeVideos ) { // Check if the quiz contains songs / videos.
-						boost::property_tree::ptree mediaTree = sub_ctrl->second;
-						boost::property_tree::ptree::const_iterator it = mediaTree.begin();
-						for ( ; it != mediaTree.end(); ++it ) {
-							if ( it->first == "QuizEntry" ) {
-								if ( it->second.get<std::string>("<xmlattr>.type") == "song" && !quizPreview.includeSongs ) {
-									quizPreview.includeSongs = true;
-								} else if ( it->second.get<std::string>("<xmlattr>.type") == "video" && !quizPreview.includeVideos ) {
-									quizPreview.includeVideos = true;
-								}
-							}
-						}
-					}
-				}
-			}
-		} else if ( ctrl->first == "QuizRowCategories" ) { // Load Row Categories
-			boost::property_tree::ptree rowCategoriesTree = ctrl->second;
-			boost::property_tree::ptree::const_iterator sub_ctrl = rowCategoriesTree.begin();
-			for ( ; sub_ctrl != rowCategoriesTree.end(); ++sub_ctrl ) {
-				if ( sub_ctrl->first == "RowCategory" ) {
-					quizPreview.rowCategories.push_back(sub_ctrl->second.data());
-				}
-			}
+		if ( !catalog->findQuiz(quizFile, idx) ) {
+			throw std::runtime_error("Quiz does not exists.");
 		}
 	}
 
-	return quizPreview;
+	return catalog->getRecord(idx).contentHash;
 }
 
-std::vector<MusicQuiz::QuizCategory*> MusicQuiz::util::QuizLoader::loadQuizCategories(const size_t idx, const media::AudioPlayer::Ptr& audioPlayer,
-	const media::VideoPlayer::Ptr& videoPlayer, std::string& err)
+std::string MusicQuiz::util::QuizLoader::getQuizFile(const std::string& quizId)
 {
-	/** Get List of Quizzes */
-	const std::vector<std::string> quizList = getListOfQuizzes();
-	if ( quizList.empty() ) {
-		throw std::runtime_error("No quizzes found in the data folder.");
+	/** Find Quiz */
+	const MusicQuiz::util::QuizCatalog::Ptr catalog = getCatalog();
+	MusicQuiz::util::QuizCatalog::QuizRecord record;
+	if ( !catalog->findQuizById(quizId, record) ) {
+		/** The quiz might have been added after the catalog was refreshed */
+		catalog->refresh();
+		if ( !catalog->findQuizById(quizId, record) ) {
+			throw std::runtime_error("Quiz does not exists.");
+		}
 	}
 
 	/** Sanity Check */
-	if ( idx >= quizList.size() ) {
-		throw std::runtime_error("No quiz index requested does not exists.");
+	if ( !boost::filesystem::exists(record.path) ) {
+		throw std::runtime_error("Quiz file does not exists.");
 	}
 
-	if ( !boost::filesystem::exists(quizList[idx]) ) {
+	return record.path;
+}
+
+MusicQuiz::util::QuizLoader::QuizPreview MusicQuiz::util::QuizLoader::getQuizPreview(const std::string& quizId)
+{
+	/** Get Quiz File */
+	const std::string quizFile = getQuizFile(quizId);
+
+	/** Preview, it is parsed and cached by the catalog if needed */
+	return getCatalog()->getPreview(quizFile);
+}
+
+MusicQuiz::util::QuizLoader::QuizPreview MusicQuiz::util::QuizLoader::parseQuizPreview(const std::string& quizFile)
+{
+	return MusicQuiz::util::QuizPreviewParser::parse(quizFile);
+}
+
+MusicQuiz::util::QuizDocument::CPtr MusicQuiz::util::QuizLoader::getQuizDocument(const std::string& quizFile)
+{
+	/** Sanity Check */
+	if ( !boost::filesystem::exists(quizFile) ) {
 		throw std::runtime_error("Quiz file does not exists.");
 	}
 
+	const std::string path = MusicQuiz::util::QuizCatalog::normalizePath(quizFile);
+	const std::time_t lastWriteTime = boost::filesystem::last_write_time(path);
+	const uintmax_t fileSize = boost::filesystem::file_size(path);
 
-	/** Load Categories */
-	LOG_INFO("Loading Quiz #" << idx << " '" << quizList[idx] << "'.");
-
-	boost::property_tree::ptree tree;
-	boost::property_tree::read_xml(quizList[idx], tree, boost::property_tree::xml_parser::trim_whitespace);
-	boost::property_tree::ptree sub_tree = tree.get_child("MusicQuiz");
-
-	std::vector<MusicQuiz::QuizCategory*> categories;
-	boost::property_tree::ptree::const_iterator ctrl = sub_tree.begin();
-	for ( ; ctrl != sub_tree.end(); ++ctrl ) {
-		if ( ctrl->first == "QuizCategories" ) { // Load Categories
-			boost::property_tree::ptree categoriesTree = ctrl->second;
-			boost::property_tree::ptree::const_iterator sub_ctrl = categoriesTree.begin();
-			try {
-				for ( ; sub_ctrl != categoriesTree.end(); ++sub_ctrl ) {
-					if ( sub_ctrl->first == "Category" ) {
-
-						/** Category Name */
-						const QString categoryName = QString::fromStdString(sub_ctrl->second.get<std::string>("<xmlattr>.name"));
-
-						/** Category Entries */
-						std::vector<MusicQuiz::QuizEntry*> categorieEntries;
-						boost::property_tree::ptree entryTree = sub_ctrl->second;
-						boost::property_tree::ptree::const_iterator it = entryTree.begin();
-						for ( ; it != entryTree.end(); ++it ) {
-							if ( it->first == "QuizEntry" ) {
-								const boost::filesystem::path full_path(boost::filesystem::current_path());
-
-								/** Settings */
-								const QString answer = QString::fromStdString(it->second.get<std::string>("Answer"));
-								const size_t points = it->second.get<size_t>("Points");
-								const size_t answerStartTime = it->second.get<size_t>("AnswerStartTime");
-
-								/** Media Type */
-								const std::string type = it->second.get<std::string>("<xmlattr>.type");
-								if ( type == "song" ) { // Song
-									QString songFile = QString::fromStdString(full_path.string() + "/" + it->second.get<std::string>("Media.SongFile"));
-									const size_t audioStartTime = it->second.get<size_t>("StartTime");
-									std::replace(songFile.begin(), songFile.end(), '\\', '/');
-
-									/** Check if file exsists */
-									if ( !boost::filesystem::exists(songFile.toStdString()) ) {
-										err += "Missing song file '" + songFile.toStdString() + "'\n";
-									}
-
-									/** Push Back Song Entry */
-									categorieEntries.push_back(new MusicQuiz::QuizEntry(songFile, answer, points, audioStartTime, answerStartTime, audioPlayer));
-								} else if ( type == "video" ) { // Video
-									QString songFile = QString::fromStdString(full_path.string() + "/" + it->second.get<std::string>("Media.SongFile"));
-									QString videoFile = QString::fromStdString(full_path.string() + "/" + it->second.get<std::string>("Media.VideoFile"));
-									std::replace(songFile.begin(), songFile.end(), '\\', '/');
-									std::replace(videoFile.begin(), videoFile.end(), '\\', '/');
-									const size_t videoStartTime = it->second.get<size_t>("StartTime");
-									const size_t videoSongStartTime = it->second.get<size_t>("VideoSongStartTime");
-
-									/** Check if files exsists */
-									if ( !boost::filesystem::exists(songFile.toStdString()) ) {
-										err += "Missing song file '" + songFile.toStdString() + "'\n";
-									}
-
-									if ( !boost::filesystem::exists(videoFile.toStdString()) ) {
-										err += "Missing video file '" + videoFile.toStdString() + "'\n";
-									}
-
-									/** Push Back Video Entry */
-									categorieEntries.push_back(new MusicQuiz::QuizEntry(songFile, videoFile, answer, points, videoSongStartTime, videoStartTime, answerStartTime, audioPlayer, videoPlayer));
-								}
-							}
-						}
-
-						categories.push_back(new MusicQuiz::QuizCategory(categoryName, categorieEntries));
-					}
-				}
-			} catch ( const std::exception& error ) {
-				LOG_ERROR("Failed to load category. " << error.what());
-			} catch ( ... ) {
-				LOG_ERROR("Failed to load category.");
+	/** Cached Document */
+	{
+		std::lock_guard<std::mutex> lock(documentCacheMutex);
+		for ( auto it = documentCache.begin(); it != documentCache.end(); ++it ) {
+			if ( (*it)->path != path ) {
+				continue;
 			}
 
+			if ( (*it)->lastWriteTime == lastWriteTime && (*it)->fileSize == fileSize ) {
+				documentCache.splice(documentCache.begin(), documentCache, it);
+				return documentCache.front();
+			}
+
+			documentCache.erase(it);
+			break;
 		}
 	}
 
-	return categories;
+	/** Parse, the compiled quiz is only read when a quiz is played */
+	const MusicQuiz::util::QuizDocument::CPtr document = MusicQuiz::util::QuizDocument::load(path);
+
+	/** Add to Cache */
+	std::lock_guard<std::mutex> lock(documentCacheMutex);
+	documentCache.push_front(document);
+	if ( documentCache.size() > DOCUMENT_CACHE_SIZE ) {
+		documentCache.pop_back();
+	}
+
+	return document;
 }
 
-std::vector<QString> MusicQuiz::util::QuizLoader::loadQuizRowCategories(const size_t idx)
+MusicQuiz::util::QuizModel::CPtr MusicQuiz::util::QuizLoader::loadQuizModel(const std::string& quizId, const MusicQuiz::QuizSettings& settings)
 {
-	/** Get List of Quizzes */
-	const std::vector<std::string> quizList = getListOfQuizzes();
-	if ( quizList.empty() ) {
-		throw std::runtime_error("No quizzes found in the data folder.");
+	/** Get Quiz */
+	const std::string quizFile = getQuizFile(quizId);
+
+	/** Model */
+	LOG_INFO("Loading Quiz " << quizId << " '" << quizFile << "'.");
+	const std::string fullPath = boost::filesystem::current_path().string();
+	MusicQuiz::util::QuizModel::Ptr model = std::make_shared<MusicQuiz::util::QuizModel>();
+	model->quizId = quizId;
+	model->quizFile = quizFile;
+
+	/** Quiz Pack, the quiz id is the content hash of the quiz file */
+	model->quizPack = MusicQuiz::util::QuizPack::open(MusicQuiz::util::QuizPack::getPackFile(quizFile), quizId);
+
+	/** Load Quiz, from the compiled quiz if it is up to date and else from the quiz document */
+	const MusicQuiz::util::QuizBinary::CPtr binary = MusicQuiz::util::QuizBinary::open(MusicQuiz::util::QuizBinary::getBinaryFile(quizFile), quizId);
+	const MusicQuiz::util::QuizDocument::CPtr document = binary == nullptr ? getQuizDocument(quizFile) : nullptr;
+	if ( binary != nullptr ) {
+		const MusicQuiz::util::QuizBinary::Header& header = binary->getHeader();
+		model->quizName = std::string(binary->getString(header.quizName));
+		model->quizAuthor = std::string(binary->getString(header.quizAuthor));
+		model->guessTheCategory = binary->isGuessTheCategory();
+		for ( size_t i = 0; i < header.rowCategoryCount; ++i ) {
+			model->rowCategories.push_back(std::string(binary->getRowCategory(i)));
+		}
+	} else {
+		model->quizName = document->quizName;
+		model->quizAuthor = document->quizAuthor;
+		model->guessTheCategory = document->guessTheCategory;
+		model->rowCategories = document->rowCategories;
 	}
 
-	/** Sanity Check */
-	if ( idx >= quizList.size() ) {
-		throw std::runtime_error("No quiz index requested does not exists.");
+	/** Load Categories */
+	try {
+		if ( binary != nullptr ) {
+			loadCategories(*model, *binary, fullPath);
+		} else {
+			loadCategories(*model, *document, fullPath);
+		}
+	} catch ( const std::exception& error ) {
+		LOG_ERROR("Failed to load category. " << error.what());
+	} catch ( ... ) {
+		LOG_ERROR("Failed to load category.");
 	}
 
-	if ( !boost::filesystem::exists(quizList[idx]) ) {
-		throw std::runtime_error("Quiz file does not exists.");
+	/** Media Files */
+	model->missingMedia = MusicQuiz::util::MediaValidator::validate(*model);
+	if ( !model->missingMedia.empty() ) {
+		LOG_WARN("Quiz " << quizId << " is missing " << model->missingMedia.missingMedia.size() << " of " << model->missingMedia.checkedFiles << " media files.");
 	}
 
-
-	/** Load Row Categories */
-	boost::property_tree::ptree tree;
-	boost::property_tree::read_xml(quizList[idx], tree, boost::property_tree::xml_parser::trim_whitespace);
-	boost::property_tree::ptree sub_tree = tree.get_child("MusicQuiz");
-
-	std::vector<QString> rowCategories;
-	boost::property_tree::ptree::const_iterator ctrl = sub_tree.begin();
-	for ( ; ctrl != sub_tree.end(); ++ctrl ) {
-		if ( ctrl->first == "QuizRowCategories" ) { // Load Categories
-			boost::property_tree::ptree rowCategoriesTree = ctrl->second;
-			boost::property_tree::ptree::const_iterator sub_ctrl = rowCategoriesTree.begin();
-			for ( ; sub_ctrl != rowCategoriesTree.end(); ++sub_ctrl ) {
-				if ( sub_ctrl->first == "RowCategory" ) {
-					rowCategories.push_back(QString::fromStdString(sub_ctrl->second.data()));
-				}
-			}
+	/** Staging, the entries play the local copies of the media */
+	if ( settings.stageMedia ) {
+		try {
+			MusicQuiz::util::MediaStagingCache stagingCache("./data/.staging/", static_cast<uintmax_t>(settings.stagingCacheSize) * 1024 * 1024);
+			stagingCache.stage(*model);
+		} catch ( const std::exception& err ) {
+			LOG_WARN("Failed to stage the media of quiz " << quizId << ". " << err.what());
 		}
 	}
 
-	return rowCategories;
+	/** Daily Double & Triple */
+	selectDailyEntries(*model, settings);
+
+	return model;
+}
+
+std::future<MusicQuiz::util::QuizModel::CPtr> MusicQuiz::util::QuizLoader::loadQuizModelAsync(const std::string& quizId, const MusicQuiz::QuizSettings& settings)
+{
+	return std::async(std::launch::async, [quizId, settings]() {
+		return loadQuizModel(quizId, settings);
+	});
 }
\ No newline at end of file
@@ -3,15 +3,16 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <future>
 #include <iostream>
 
-#include <QString>
-
 #include <boost/filesystem.hpp>
 
-#include "media/AudioPlayer.hpp"
-#include "media/VideoPlayer.hpp"
-#include "gui_tools/widgets/QuizCategory.hpp"
+#include "util/QuizModel.hpp"
+#include "util/QuizPreview.hpp"
+#include "util/QuizSettings.hpp"
+#include "util/QuizCatalog.hpp"
+#include "util/QuizDocument.hpp"
 
 
 namespace MusicQuiz {
@@ -19,42 +20,10 @@ namespace MusicQuiz {
 		class QuizLoader
 		{
 		public:
-			struct QuizPreview
-			{
-				std::string quizName = "";
-				std::string quizAuthor = "";
-				bool includeSongs = false;
-				bool includeVideos = false;
-				bool guessTheCategory = false;
-				std::string quizDescription = "";
-				std::vector<std::string> categories;
-				std::vector<std::string> rowCategories;
-
-				friend std::ostream& operator<<(std::ostream& out, const QuizPreview& quizPreview)
-				{
-					out << "\n\nQuiz Name: " << quizPreview.quizName << "\n";
-					out << "Quiz Author: " << quizPreview.quizAuthor << "\n";
-					out << "Quiz Description: " << quizPreview.quizDescription << "\n";
-					if ( !quizPreview.categories.empty() ) {
-						out << "Quiz Categories:\n";
-						for ( size_t i = 0; i < quizPreview.categories.size(); ++i ) {
-							out << "\t" << quizPreview.categories[i] << "\n";
-						}
-					}
-
-					if ( !quizPreview.rowCategories.empty() ) {
-						out << "Quiz Row Categories:\n";
-						for ( size_t i = 0; i < quizPreview.rowCategories.size(); ++i ) {
-							out << "\t" << quizPreview.rowCategories[i] << "\n";
-						}
-					}
-
-					out << "Quiz Include Songs: " << (quizPreview.includeSongs ? "Yes" : "No") << "\n";
-					out << "Quiz Include Videos: " << (quizPreview.includeVideos ? "Yes" : "No") << "\n";
-					out << "Quiz Quess the Category: " << (quizPreview.guessTheCategory ? "Yes" : "No") << "\n\n";
-					return out;
-				}
-			};
+			/**
+			 * @brief The quiz preview type.
+			 */
+			typedef MusicQuiz::util::QuizPreview QuizPreview;
 
 			/**
 			 * @brief Deleted constructor.
@@ -73,41 +42,88 @@ namespace MusicQuiz {
 			QuizLoader& operator=(const QuizLoader&) = delete;
 
 			/**
-			* @brief Returns a list of quizzez stored in the data folder.
+			* @brief Returns the quiz catalog of the data folder.
+			*
+			* @return The quiz catalog.
+			*/
+			static std::shared_ptr< MusicQuiz::util::QuizCatalog > getCatalog();
+
+			/**
+			* @brief Returns a list of quizzez stored in the data folder. The quiz catalog is refreshed.
 			*
 			* @return The list of quizzes.
 			*/
 			static std::vector<std::string> getListOfQuizzes();
 
+			/**
+			* @brief Returns the id of a quiz file. The quiz catalog is refreshed if the quiz is not in the catalog.
+			*
+			* @param[in] quizFile The quiz file.
+			*
+			* @return The quiz id.
+			*/
+			static std::string getQuizId(const std::string& quizFile);
+
+			/**
+			* @brief Returns the quiz file of a quiz id. The quiz catalog is refreshed if the quiz is not in the catalog.
+			*
+			* @param[in] quizId The quiz id.
+			*
+			* @return The quiz file.
+			*/
+			static std::string getQuizFile(const std::string& quizId);
+
 			/**
 			* @brief Returns a quiz preview.
 			*
-			* @param[in] idx The index of the quiz to preview.
+			* @param[in] quizId The id of the quiz to preview.
 			*
 			* @return The quiz preview.
 			*/
-			static QuizPreview getQuizPreview(size_t idx);
+			static QuizPreview getQuizPreview(const std::string& quizId);
 
 			/**
-			* @brief Returns a list of the categories.
+			* @brief Parses the quiz preview of a quiz file using the streaming preview parser.
 			*
-			* @param[in] idx The index of the quiz to load the categories from.
-			* @param[out] err The error message.
+			* @param[in] quizFile The quiz file.
 			*
-			* @return The quiz categories.
+			* @return The quiz preview.
 			*/
-			static std::vector<MusicQuiz::QuizCategory*> loadQuizCategories(size_t idx, const std::shared_ptr< media::AudioPlayer >& audioPlayer,
-				const std::shared_ptr< media::VideoPlayer >& videoPlayer, std::string& err);
+			static QuizPreview parseQuizPreview(const std::string& quizFile);
 
 			/**
-			* @brief Returns a list of the row categories.
+			* @brief Returns the parsed quiz document. The last parsed documents are cached by path and modification time
+			*        such that a quiz is only parsed once when it is previewed and started.
 			*
-			* @param[in] idx The index of the quiz to load the categories from.
+			* @param[in] quizFile The quiz file.
 			*
-			* @return The quiz row categories.
+			* @return The quiz document.
 			*/
-			static std::vector<QString> loadQuizRowCategories(size_t idx);
+			static MusicQuiz::util::QuizDocument::CPtr getQuizDocument(const std::string& quizFile);
 
+			/**
+			* @brief Loads the model of a quiz. The model does not contain any widgets, such that it can be loaded on
+			*        any thread. Missing media files are reported in the missing media report of the model
+			*        (QuizModel::missingMedia) and the daily double and triple entries are selected according to the
+			*        settings. If media staging is enabled the media
+			*        files of the entries are replaced by local copies.
+			*
+			* @param[in] quizId The id of the quiz to load.
+			* @param[in] settings The quiz settings.
+			*
+			* @return The quiz model.
+			*/
+			static MusicQuiz::util::QuizModel::CPtr loadQuizModel(const std::string& quizId, const MusicQuiz::QuizSettings& settings = MusicQuiz::QuizSettings());
+
+			/**
+			* @brief Loads the model of a quiz on a worker thread.
+			*
+			* @param[in] quizId The id of the quiz to load.
+			* @param[in] settings The quiz settings.
+			*
+			* @return The future quiz model.
+			*/
+			static std::future<MusicQuiz::util::QuizModel::CPtr> loadQuizModelAsync(const std::string& quizId, const MusicQuiz::QuizSettings& settings);
 
 		protected:
 			/** Variables */
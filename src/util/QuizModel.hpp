@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <string_view>
+
+#include "common/StringArena.hpp"
+#include "util/MissingMediaReport.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		class QuizPack;
+
+		/**
+		 * @brief Widget free description of a quiz that is ready to be played.
+		 *
+		 * The media files are resolved to absolute paths and all fields required to play an entry are present, such
+		 * that the model can be loaded on a worker thread and the widgets can be created from it on the GUI thread.
+		 * The answers and media files of the entries are interned in the string arena of the model.
+		 */
+		struct QuizModel
+		{
+			enum class EntryType
+			{
+				SONG, VIDEO
+			};
+
+			struct Entry
+			{
+				EntryType type = EntryType::SONG;
+				std::string_view answer;
+				size_t points = 0;
+				std::string_view songFile;
+				std::string_view videoFile;
+				size_t songStartTime = 0;
+				size_t videoStartTime = 0;
+				size_t answerStartTime = 0;
+				bool doublePoints = false;
+				bool triplePoints = false;
+			};
+
+			struct Category
+			{
+				std::string name = "";
+				std::vector<Entry> entries;
+			};
+
+			/**
+			 * @brief Shared Pointer
+			 */
+			typedef std::shared_ptr< QuizModel > Ptr;
+			typedef std::shared_ptr< const QuizModel > CPtr;
+
+			std::string quizId = "";
+			std::string quizFile = "";
+			std::string quizName = "";
+			std::string quizAuthor = "";
+			bool guessTheCategory = false;
+
+			std::vector<Category> categories;
+			std::vector<std::string> rowCategories;
+
+			/** Pack containing the media files, nullptr if the media is played from the media folder */
+			std::shared_ptr<const QuizPack> quizPack;
+
+			/** Storage of the entry strings */
+			common::StringArena::Ptr strings = std::make_shared<common::StringArena>();
+
+			/** Media files that could not be found */
+			MusicQuiz::util::MissingMediaReport missingMedia;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,311 @@
+#include "QuizPack.hpp"
+
+#include <vector>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+#include "common/Log.hpp"
+
+
+namespace {
+	/** Version of the quiz pack format */
+	constexpr uint32_t PACK_VERSION = 1;
+
+	/** Alignment of the media blobs */
+	constexpr uint64_t BLOB_ALIGNMENT = 4096;
+
+	static_assert(sizeof(MusicQuiz::util::QuizPack::Header) == 48, "Unexpected quiz pack header size.");
+
+	/**
+	 * @brief Read only device over a mapped blob, it holds a reference to the pack such that the blob stays mapped.
+	 *        The blob is read by 64 bit offset as a QByteArray cannot hold blobs of 2 GB or more.
+	 */
+	class PackDevice : public QIODevice
+	{
+	public:
+		PackDevice(const MusicQuiz::util::QuizPack::CPtr& pack, const uchar* data, const uint64_t size, QObject* parent) :
+			QIODevice(parent), _pack(pack), _data(data), _size(static_cast<qint64>(size))
+		{
+		}
+
+		qint64 size() const override
+		{
+			return _size;
+		}
+
+	protected:
+		qint64 readData(char* data, const qint64 maxSize) override
+		{
+			const qint64 count = std::min(maxSize, _size - pos());
+			if ( count <= 0 ) {
+				return 0;
+			}
+
+			std::memcpy(data, _data + pos(), static_cast<size_t>(count));
+			return count;
+		}
+
+		qint64 writeData(const char*, qint64) override
+		{
+			return -1;
+		}
+
+	private:
+		MusicQuiz::util::QuizPack::CPtr _pack;
+		const uchar* _data = nullptr;
+		qint64 _size = 0;
+	};
+
+	uint64_t align(const uint64_t offset)
+	{
+		return (offset + BLOB_ALIGNMENT - 1) & ~(BLOB_ALIGNMENT - 1);
+	}
+
+	template <typename T>
+	void appendValue(std::vector<char>& buffer, const T& value)
+	{
+		const char* bytes = reinterpret_cast<const char*>(&value);
+		buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+	}
+
+	bool isInRange(const uint64_t offset, const uint64_t size, const uint64_t total)
+	{
+		return size <= total && offset <= total - size;
+	}
+
+	template <typename T>
+	bool readValue(const uchar* data, const uint64_t size, uint64_t& offset, T& value)
+	{
+		if ( !isInRange(offset, sizeof(T), size) ) {
+			return false;
+		}
+		std::memcpy(&value, data + offset, sizeof(T));
+		offset += sizeof(T);
+		return true;
+	}
+}
+
+
+MusicQuiz::util::QuizPack::~QuizPack()
+{
+	if ( _data != nullptr ) {
+		_file.unmap(const_cast<uchar*>(_data));
+	}
+}
+
+MusicQuiz::util::QuizPack::Ptr MusicQuiz::util::QuizPack::open(const std::string& packFile, const std::string& sourceHash)
+{
+	/** Map File */
+	QuizPack::Ptr pack = std::make_shared<QuizPack>();
+	pack->_file.setFileName(QString::fromStdString(packFile));
+	if ( !pack->_file.exists() || !pack->_file.open(QIODevice::ReadOnly) ) {
+		return nullptr;
+	}
+
+	pack->_size = static_cast<size_t>(pack->_file.size());
+	if ( pack->_size < sizeof(Header) ) {
+		return nullptr;
+	}
+
+	pack->_data = pack->_file.map(0, pack->_file.size());
+	if ( pack->_data == nullptr ) {
+		LOG_WARN("Failed to map quiz pack '" << packFile << "'. " << pack->_file.errorString().toStdString());
+		return nullptr;
+	}
+
+	/** Header */
+	Header header;
+	const Header expected;
+	std::memcpy(&header, pack->_data, sizeof(Header));
+	if ( std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != PACK_VERSION ) {
+		return nullptr;
+	}
+
+	if ( sourceHash.size() != sizeof(header.sourceHash) || std::memcmp(header.sourceHash, sourceHash.data(), sizeof(header.sourceHash)) != 0 ) {
+		return nullptr;
+	}
+
+	if ( !isInRange(header.tocOffset, header.tocSize, pack->_size) ) {
+		return nullptr;
+	}
+
+	/** Table of Contents */
+	uint64_t offset = header.tocOffset;
+	const uint64_t tocEnd = header.tocOffset + header.tocSize;
+	for ( uint32_t i = 0; i < header.fileCount; ++i ) {
+		Blob blob;
+		uint32_t pathSize = 0;
+		if ( !readValue(pack->_data, tocEnd, offset, blob.offset) || !readValue(pack->_data, tocEnd, offset, blob.size) ||
+			!readValue(pack->_data, tocEnd, offset, pathSize) || !isInRange(offset, pathSize, tocEnd) || !isInRange(blob.offset, blob.size, pack->_size) ) {
+			LOG_WARN("Invalid table of contents in quiz pack '" << packFile << "'.");
+			return nullptr;
+		}
+
+		pack->_blobs.emplace(std::string(reinterpret_cast<const char*>(pack->_data + offset), pathSize), blob);
+		offset += pathSize;
+	}
+
+	/** Quiz Folder, the media files are stored relative to it */
+	pack->_quizFolder = boost::filesystem::absolute(boost::filesystem::path(packFile).parent_path()).lexically_normal().generic_string();
+
+	return pack;
+}
+
+void MusicQuiz::util::QuizPack::write(const std::string& quizFolder, const std::string& sourceHash, const std::string& packFile)
+{
+	/** Sanity Check */
+	Header header;
+	if ( sourceHash.size() != sizeof(header.sourceHash) ) {
+		throw std::runtime_error("Invalid source hash for quiz pack.");
+	}
+
+	/** Media Files, sorted such that the same media gives the same pack */
+	std::vector<std::string> mediaFiles;
+	const boost::filesystem::path mediaFolder = boost::filesystem::path(quizFolder) / "media";
+	if ( boost::filesystem::is_directory(mediaFolder) ) {
+		boost::filesystem::recursive_directory_iterator end;
+		for ( boost::filesystem::recursive_directory_iterator it(mediaFolder); it != end; ++it ) {
+			if ( boost::filesystem::is_regular_file(it->path()) ) {
+				mediaFiles.push_back(it->path().lexically_relative(quizFolder).generic_string());
+			}
+		}
+	}
+	std::sort(mediaFiles.begin(), mediaFiles.end());
+
+	/** Table of Contents */
+	uint64_t tocSize = 0;
+	for ( size_t i = 0; i < mediaFiles.size(); ++i ) {
+		tocSize += sizeof(uint64_t) * 2 + sizeof(uint32_t) + mediaFiles[i].size();
+	}
+
+	std::vector<char> toc;
+	uint64_t offset = align(sizeof(Header) + tocSize);
+	for ( size_t i = 0; i < mediaFiles.size(); ++i ) {
+		const uint64_t size = boost::filesystem::file_size(boost::filesystem::path(quizFolder) / mediaFiles[i]);
+		appendValue(toc, offset);
+		appendValue(toc, size);
+		appendValue(toc, static_cast<uint32_t>(mediaFiles[i].size()));
+		toc.insert(toc.end(), mediaFiles[i].begin(), mediaFiles[i].end());
+		offset = align(offset + size);
+	}
+
+	/** Header */
+	header.version = PACK_VERSION;
+	header.fileCount = static_cast<uint32_t>(mediaFiles.size());
+	std::memcpy(header.sourceHash, sourceHash.data(), sizeof(header.sourceHash));
+	header.tocOffset = sizeof(Header);
+	header.tocSize = tocSize;
+
+	/** Write to a temporary file and replace the pack such that it is never left half written */
+	const std::string tmpFile = packFile + ".tmp";
+	{
+		std::ofstream file(tmpFile, std::ios::binary | std::ios::trunc);
+		if ( !file.is_open() ) {
+			throw std::runtime_error("Failed to open '" + tmpFile + "' for writing.");
+		}
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+		file.write(toc.data(), static_cast<std::streamsize>(toc.size()));
+
+		/** Media Blobs */
+		for ( size_t i = 0; i < mediaFiles.size(); ++i ) {
+			const std::streamoff padding = static_cast<std::streamoff>(align(static_cast<uint64_t>(file.tellp()))) - file.tellp();
+			const std::vector<char> zeros(static_cast<size_t>(padding), '\0');
+			file.write(zeros.data(), padding);
+
+			std::ifstream mediaFile((boost::filesystem::path(quizFolder) / mediaFiles[i]).string(), std::ios::binary);
+			if ( !mediaFile.is_open() ) {
+				throw std::runtime_error("Failed to open '" + mediaFiles[i] + "' for reading.");
+			}
+
+			if ( boost::filesystem::file_size(boost::filesystem::path(quizFolder) / mediaFiles[i]) > 0 ) {
+				file << mediaFile.rdbuf();
+			}
+		}
+
+		if ( !file ) {
+			throw std::runtime_error("Failed to write '" + tmpFile + "'.");
+		}
+	}
+	boost::filesystem::rename(tmpFile, packFile);
+}
+
+bool MusicQuiz::util::QuizPack::updateSourceHash(const std::string& packFile, const std::string& previousHash, const std::string& sourceHash)
+{
+	/** Sanity Check */
+	Header header;
+	if ( previousHash.size() != sizeof(header.sourceHash) || sourceHash.size() != sizeof(header.sourceHash) ) {
+		return false;
+	}
+
+	std::fstream file(packFile, std::ios::binary | std::ios::in | std::ios::out);
+	if ( !file.is_open() || !file.read(reinterpret_cast<char*>(&header), sizeof(Header)) ) {
+		return false;
+	}
+
+	/** Only a pack that is valid for the previous quiz file is valid for the new one */
+	const Header expected;
+	if ( std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != PACK_VERSION ||
+		std::memcmp(header.sourceHash, previousHash.data(), sizeof(header.sourceHash)) != 0 ) {
+		return false;
+	}
+
+	std::memcpy(header.sourceHash, sourceHash.data(), sizeof(header.sourceHash));
+	file.seekp(0);
+	file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+	file.flush();
+	return static_cast<bool>(file);
+}
+
+std::string MusicQuiz::util::QuizPack::getPackFile(const std::string& quizFile)
+{
+	const std::string extension = ".quiz.xml";
+	if ( quizFile.size() > extension.size() && quizFile.compare(quizFile.size() - extension.size(), extension.size(), extension) == 0 ) {
+		return quizFile.substr(0, quizFile.size() - extension.size()) + ".quizpack";
+	}
+	return quizFile + ".quizpack";
+}
+
+bool MusicQuiz::util::QuizPack::contains(const std::string& mediaFile) const
+{
+	Blob blob;
+	return findBlob(mediaFile, blob);
+}
+
+QIODevice* MusicQuiz::util::QuizPack::createDevice(const std::string& mediaFile, QObject* parent) const
+{
+	Blob blob;
+	if ( !findBlob(mediaFile, blob) ) {
+		return nullptr;
+	}
+
+	PackDevice* device = new PackDevice(shared_from_this(), _data + blob.offset, blob.size, parent);
+	device->open(QIODevice::ReadOnly);
+	return device;
+}
+
+size_t MusicQuiz::util::QuizPack::size() const
+{
+	return _blobs.size();
+}
+
+bool MusicQuiz::util::QuizPack::findBlob(const std::string& mediaFile, Blob& blob) const
+{
+	/** Relative Path */
+	boost::filesystem::path path = boost::filesystem::path(mediaFile).lexically_normal();
+	if ( path.is_absolute() ) {
+		path = path.lexically_relative(_quizFolder);
+	}
+
+	const auto it = _blobs.find(path.generic_string());
+	if ( it == _blobs.end() ) {
+		return false;
+	}
+
+	blob = it->second;
+	return true;
+}
\ No newline at end of file
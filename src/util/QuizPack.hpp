@@ -0,0 +1,151 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <unordered_map>
+
+#include <QFile>
+#include <QObject>
+#include <QIODevice>
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Single file containing the media of a quiz, stored next to the quiz as '<Name>.quizpack'.
+		 *
+		 * The file consists of a header, a table of contents and the media files stored as page aligned blobs. The
+		 * pack is memory mapped and the media is played from devices reading the mapped blobs, such that a quiz can
+		 * be copied and opened as a few large files instead of thousands of small ones. The media files are stored
+		 * relative to the quiz folder and the header stores the content hash of the quiz file, a pack written for
+		 * another version of the quiz is ignored.
+		 */
+		class QuizPack : public std::enable_shared_from_this<QuizPack>
+		{
+		public:
+			struct Header
+			{
+				char magic[8] = { 'M', 'Q', 'U', 'I', 'Z', 'P', 'A', 'K' };
+				uint32_t version = 0;
+				uint32_t fileCount = 0;
+				char sourceHash[16] = {};
+				uint64_t tocOffset = 0;
+				uint64_t tocSize = 0;
+			};
+
+			/**
+			 * @brief Shared Pointer
+			 */
+			typedef std::shared_ptr< QuizPack > Ptr;
+			typedef std::shared_ptr< const QuizPack > CPtr;
+
+			/**
+			 * @brief Constructor, use open to map a quiz pack.
+			 */
+			QuizPack() = default;
+
+			/**
+			 * @brief Destructor, unmaps the file.
+			 */
+			virtual ~QuizPack();
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			QuizPack(const QuizPack&) = delete;
+			QuizPack& operator=(const QuizPack&) = delete;
+
+			/**
+			 * @brief Memory maps and validates a quiz pack.
+			 *
+			 * @param[in] packFile The quiz pack file.
+			 * @param[in] sourceHash The content hash of the quiz file.
+			 *
+			 * @return The quiz pack or nullptr if the file is missing, invalid or written for another version of the quiz.
+			 */
+			static Ptr open(const std::string& packFile, const std::string& sourceHash);
+
+			/**
+			 * @brief Packs the media folder of a quiz. The file is written to a temporary file and renamed.
+			 *
+			 * @param[in] quizFolder The quiz folder, all files in its 'media' folder are packed.
+			 * @param[in] sourceHash The content hash of the quiz file.
+			 * @param[in] packFile The quiz pack file.
+			 */
+			static void write(const std::string& quizFolder, const std::string& sourceHash, const std::string& packFile);
+
+			/**
+			 * @brief Updates the source hash of a pack whose media is unchanged, such that the media is not packed again
+			 *        when only the quiz file changed.
+			 *
+			 * @param[in] packFile The quiz pack file.
+			 * @param[in] previousHash The content hash of the quiz file the pack was written for.
+			 * @param[in] sourceHash The content hash of the new quiz file.
+			 *
+			 * @return True if the pack was updated, false if it is missing or was not written for the previous hash.
+			 */
+			static bool updateSourceHash(const std::string& packFile, const std::string& previousHash, const std::string& sourceHash);
+
+			/**
+			 * @brief Returns the quiz pack file of a quiz file.
+			 *
+			 * @param[in] quizFile The quiz file.
+			 *
+			 * @return The quiz pack file.
+			 */
+			static std::string getPackFile(const std::string& quizFile);
+
+			/**
+			 * @brief Checks if the pack contains a media file.
+			 *
+			 * @param[in] mediaFile The media file, either absolute or relative to the quiz folder.
+			 *
+			 * @return True if the pack contains the file.
+			 */
+			bool contains(const std::string& mediaFile) const;
+
+			/**
+			 * @brief Creates a read only device that reads a media file from the mapped pack. The device keeps the pack
+			 *        mapped until it is deleted.
+			 *
+			 * @param[in] mediaFile The media file, either absolute or relative to the quiz folder.
+			 * @param[in] parent The parent of the device.
+			 *
+			 * @return The opened device or nullptr if the pack does not contain the file.
+			 */
+			QIODevice* createDevice(const std::string& mediaFile, QObject* parent = nullptr) const;
+
+			/**
+			 * @brief Returns the number of media files in the pack.
+			 *
+			 * @return The number of media files.
+			 */
+			size_t size() const;
+
+		private:
+			struct Blob
+			{
+				uint64_t offset = 0;
+				uint64_t size = 0;
+			};
+
+			/**
+			 * @brief Finds the blob of a media file.
+			 *
+			 * @param[in] mediaFile The media file, either absolute or relative to the quiz folder.
+			 * @param[out] blob The blob.
+			 *
+			 * @return True if the pack contains the file.
+			 */
+			bool findBlob(const std::string& mediaFile, Blob& blob) const;
+
+			/** Variables */
+			QFile _file;
+			const uchar* _data = nullptr;
+			size_t _size = 0;
+			std::string _quizFolder = "";
+			std::unordered_map<std::string, Blob> _blobs;
+		};
+	}
+}
\ No newline at end of file
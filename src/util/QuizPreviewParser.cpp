@@ -0,0 +1,130 @@
+#include "QuizPreviewParser.hpp"
+
+#include <stdexcept>
+
+#include <QFile>
+#include <QString>
+#include <QXmlStreamReader>
+
+
+namespace {
+	std::string readText(QXmlStreamReader& xml)
+	{
+		/** Whitespace is normalized the same way as the property tree parser does it */
+		return xml.readElementText().simplified().toStdString();
+	}
+
+	void readCategories(QXmlStreamReader& xml, MusicQuiz::util::QuizPreview& preview)
+	{
+		while ( xml.readNextStartElement() ) {
+			if ( xml.name() != QLatin1String("Category") ) {
+				xml.skipCurrentElement();
+				continue;
+			}
+
+			/** Category Name */
+			const QXmlStreamAttributes attributes = xml.attributes();
+			if ( !attributes.hasAttribute(QLatin1String("name")) ) {
+				throw std::runtime_error("No such node (<xmlattr>.name)");
+			}
+			preview.categories.push_back(attributes.value(QLatin1String("name")).toString().toStdString());
+
+			/** Check if the quiz contains songs / videos, the entries are skipped once both are known */
+			while ( !(preview.includeSongs && preview.includeVideos) && xml.readNextStartElement() ) {
+				if ( xml.name() == QLatin1String("QuizEntry") ) {
+					const QStringRef type = xml.attributes().value(QLatin1String("type"));
+					if ( type == QLatin1String("song") ) {
+						preview.includeSongs = true;
+					} else if ( type == QLatin1String("video") ) {
+						preview.includeVideos = true;
+					}
+				}
+				xml.skipCurrentElement();
+			}
+
+			if ( xml.isStartElement() || (xml.isEndElement() && xml.name() != QLatin1String("Category")) ) {
+				xml.skipCurrentElement();
+			}
+		}
+	}
+
+	void readRowCategories(QXmlStreamReader& xml, MusicQuiz::util::QuizPreview& preview)
+	{
+		while ( xml.readNextStartElement() ) {
+			if ( xml.name() == QLatin1String("RowCategory") ) {
+				preview.rowCategories.push_back(readText(xml));
+			} else {
+				xml.skipCurrentElement();
+			}
+		}
+	}
+}
+
+
+MusicQuiz::util::QuizPreview MusicQuiz::util::QuizPreviewParser::parse(const std::string& quizFile)
+{
+	/** Open File */
+	QFile file(QString::fromStdString(quizFile));
+	if ( !file.open(QIODevice::ReadOnly) ) {
+		throw std::runtime_error("Quiz file does not exists.");
+	}
+
+	/** Root */
+	QXmlStreamReader xml(&file);
+	if ( !xml.readNextStartElement() || xml.name() != QLatin1String("MusicQuiz") ) {
+		throw std::runtime_error("No such node (MusicQuiz)");
+	}
+
+	/** Read until all preview fields are known */
+	QuizPreview preview;
+	bool hasName = false, hasAuthor = false, hasDescription = false;
+	bool hasCategories = false, hasRowCategories = false;
+	while ( xml.readNextStartElement() ) {
+		if ( xml.name() == QLatin1String("QuizName") ) {
+			preview.quizName = readText(xml);
+			hasName = true;
+		} else if ( xml.name() == QLatin1String("QuizAuthor") ) {
+			preview.quizAuthor = readText(xml);
+			hasAuthor = true;
+		} else if ( xml.name() == QLatin1String("QuizDescription") ) {
+			preview.quizDescription = readText(xml);
+			hasDescription = true;
+		} else if ( xml.name() == QLatin1String("QuizGuessTheCategory") ) {
+			const QStringRef enabled = xml.attributes().value(QLatin1String("enabled"));
+			preview.guessTheCategory = (enabled == QLatin1String("true") || enabled == QLatin1String("1"));
+			xml.skipCurrentElement();
+		} else if ( xml.name() == QLatin1String("QuizCategories") ) {
+			readCategories(xml, preview);
+			hasCategories = true;
+		} else if ( xml.name() == QLatin1String("QuizRowCategories") ) {
+			readRowCategories(xml, preview);
+			hasRowCategories = true;
+		} else {
+			xml.skipCurrentElement();
+		}
+
+		/** Stop early, the rest of the file is not needed */
+		if ( hasName && hasAuthor && hasDescription && hasCategories && hasRowCategories ) {
+			break;
+		}
+	}
+
+	/** Sanity Check */
+	if ( xml.hasError() ) {
+		throw std::runtime_error("Failed to parse quiz file. " + xml.errorString().toStdString());
+	}
+
+	if ( !hasName ) {
+		throw std::runtime_error("No such node (QuizName)");
+	}
+
+	if ( !hasAuthor ) {
+		throw std::runtime_error("No such node (QuizAuthor)");
+	}
+
+	if ( !hasDescription ) {
+		throw std::runtime_error("No such node (QuizDescription)");
+	}
+
+	return preview;
+}
\ No newline at end of file
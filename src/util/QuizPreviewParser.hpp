@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+
+#include "util/QuizPreview.hpp"
+
+
+namespace MusicQuiz {
+	namespace util {
+		/**
+		 * @brief Streaming parser for quiz previews.
+		 *
+		 * The quiz file is read as a stream of XML tokens and no document tree is built. The content of the entries
+		 * is skipped, only the type attribute is read until it is known that the quiz contains both songs and videos.
+		 * Parsing stops as soon as all preview fields have been read, so the memory used does not depend on the size
+		 * of the quiz.
+		 */
+		class QuizPreviewParser
+		{
+		public:
+			/**
+			 * @brief Deleted constructor.
+			 */
+			QuizPreviewParser() = delete;
+
+			/**
+			* @brief Deleted Destructor.
+			*/
+			~QuizPreviewParser() = delete;
+
+			/**
+			 * @brief Deleted the copy and assignment constructor.
+			 */
+			QuizPreviewParser(const QuizPreviewParser&) = delete;
+			QuizPreviewParser& operator=(const QuizPreviewParser&) = delete;
+
+			/**
+			* @brief Parses the quiz preview of a quiz file.
+			*
+			* @param[in] quizFile The quiz file.
+			*
+			* @return The quiz preview.
+			*/
+			static QuizPreview parse(const std::string& quizFile);
+		};
+	}
+}
\ No newline at end of file
@@ -24,5 +24,17 @@ namespace MusicQuiz {
 		/** Guess the category */
 		bool guessTheCategory = false;
 		size_t pointsPerCategory = 500;
+
+		/** Media of the selected quiz read into the page cache in the background, limited to the bandwidth in MB/s */
+		bool prefetchMedia = true;
+		size_t prefetchBandwidth = 16;
+
+		/** Media copied to a local cache directory before the quiz starts, the least recently used media is evicted
+		    when the cache exceeds its size in MB */
+		bool stageMedia = false;
+		size_t stagingCacheSize = 8192;
+
+		/** Latency report of the entry clicks written to ./data/latency/ when the game ends */
+		bool latencyReport = false;
 	};
 }
\ No newline at end of file